@@ -0,0 +1,408 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_ARENA_HXX_
+#define _C0DE4UN_ARENA_HXX_
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::uintptr_t
+#include <cstdint>
+
+// Include ::operator new, ::operator delete
+#include <new>
+
+// Include std::forward, std::move
+#include <utility>
+
+// Include std::is_trivially_destructible
+#include <type_traits>
+
+// Include fast_ptr
+#include "fast_ptr.hxx"
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_ARENA_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * arena_ptr - non-owning pointer to an object, allocated by arena.
+	 *
+	 * (?) Does no counting, object lives until arena reset.
+	 *
+	 * @version 0.1.0
+	*/
+	template <typename T>
+	class arena_ptr final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Object instance, stored in arena memory */
+		T * mObject;
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructors
+		// ===========================================================
+
+		/*
+		 * arena_ptr Constructor with initial value
+		 *
+		 * @param pObject - object instance, allocated by arena
+		*/
+		explicit arena_ptr( T *const pObject = nullptr ) noexcept
+			: mObject( pObject )
+		{
+		}
+
+		// ===========================================================
+		// Methods & Operators
+		// ===========================================================
+
+		/* Returns 'reference'. (!) Don't call on null-value. */
+		T & getRef( ) const noexcept
+		{ return( *mObject ); }
+
+		/* Returns 'raw-pointer' */
+		T *const getPtr( ) const noexcept
+		{ return( mObject ); }
+
+		/* Returns 'raw-pointer' to the object instance, can be null. Same as #getPtr. */
+		T *const operator*( ) const noexcept
+		{ return( mObject ); }
+
+		/* Returns true if 'pointer' is nullptr */
+		const bool operator==( std::nullptr_t ) const noexcept
+		{ return( mObject == nullptr ); }
+
+		/* Returns true if 'pointer' is not nullptr */
+		const bool operator!=( std::nullptr_t ) const noexcept
+		{ return( mObject != nullptr ); }
+
+		/* Pointer address access operator */
+		T *const operator->( ) const noexcept
+		{ return( mObject ); }
+
+		/* Returns true if this instance stores same object as given one. */
+		const bool operator==( const arena_ptr<T> & pOther ) const noexcept
+		{ return( mObject == pOther.mObject ); }
+
+		/* Returns true if given object instance is the same as the stored one. */
+		const bool operator==( T *const pObject ) const noexcept
+		{ return( mObject == pObject ); }
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	/*
+	 * arena - bump-allocator for objects, which are released together.
+	 *
+	 * Objects are never counted nor released one by one: #reset runs all
+	 * destructors (in reverse order of construction) & releases memory at once.
+	 * Use #promote to move object out to a fast_ptr, if it must outlive the arena.
+	 *
+	 * (!) Not thread-safe, use one arena per request (thread).
+	 *
+	 * @version 0.1.0
+	*/
+	class arena final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Types
+		// ===========================================================
+
+		/* Memory block header, data follows it */
+		struct arena_block
+		{
+
+			/* Previous (filled) block */
+			arena_block * mNext;
+
+			/* Bytes available after the header */
+			std::size_t mSize;
+
+			/* Bytes used */
+			std::size_t mUsed;
+
+		};
+
+		/* Destructor record, stored in arena memory */
+		struct arena_destructor
+		{
+
+			/* Previous record */
+			arena_destructor * mNext;
+
+			/* Object instance */
+			void * mObject;
+
+			/* Type-specific destroy function */
+			void ( *mDestroy )( void *const );
+
+		};
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Current block, head of the blocks list */
+		arena_block * mBlock;
+
+		/* Last registered destructor, head of the records list */
+		arena_destructor * mDestructors;
+
+		/* Default block size (bytes) */
+		const std::size_t mBlockSize;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Returns first byte of the block data */
+		static char *const blockData( arena_block *const pBlock ) noexcept
+		{ return( reinterpret_cast<char*>( pBlock ) + sizeof( arena_block ) ); }
+
+		/*
+		 * Allocates new block, at least of given size.
+		 *
+		 * @param pSize - bytes required.
+		 * @throws - std::bad_alloc.
+		*/
+		void addBlock( const std::size_t pSize )
+		{
+
+			// Block data size
+			const std::size_t size_( pSize > mBlockSize ? pSize : mBlockSize );
+
+			// Allocate
+			arena_block *const block_lp( static_cast<arena_block*>( ::operator new( sizeof( arena_block ) + size_ ) ) );
+
+			// Initialize
+			block_lp->mNext = mBlock;
+			block_lp->mSize = size_;
+			block_lp->mUsed = 0;
+
+			// Set as current
+			mBlock = block_lp;
+
+		}
+
+		/* Calls object destructor */
+		template <typename T>
+		static void destroy( void *const pObject ) noexcept
+		{ static_cast<T*>( pObject )->~T( ); }
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructor & destructor
+		// ===========================================================
+
+		/*
+		 * arena constructor
+		 *
+		 * (?) Memory is not allocated until first object.
+		 *
+		 * @param pBlockSize - default block size (bytes).
+		*/
+		explicit arena( const std::size_t pBlockSize = 4096 ) noexcept
+			: mBlock( nullptr ),
+			mDestructors( nullptr ),
+			mBlockSize( pBlockSize )
+		{
+		}
+
+		/* arena destructor */
+		~arena( ) noexcept
+		{
+
+			// Destroy objects
+			reset( );
+
+			// Release kept block
+			if ( mBlock != nullptr )
+				::operator delete( mBlock );
+
+		}
+
+		// ===========================================================
+		// Deleted
+		// ===========================================================
+
+		/* @deleted arena const copy constructor */
+		arena( const arena & ) = delete;
+
+		/* @deleted arena const copy assignment operator */
+		arena & operator=( const arena & ) = delete;
+
+		/* @deleted arena move constructor */
+		arena( arena && ) = delete;
+
+		/* @deleted arena move assignment operator */
+		arena & operator=( arena && ) = delete;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Allocates raw memory.
+		 *
+		 * @param pSize - bytes.
+		 * @param pAlignment - alignment, power of 2.
+		 * @return - memory, valid until #reset.
+		 * @throws - std::bad_alloc.
+		*/
+		void *const allocate( const std::size_t pSize, const std::size_t pAlignment = alignof( std::max_align_t ) )
+		{
+
+			// Try current block
+			if ( mBlock != nullptr )
+			{
+
+				// Aligned address
+				const std::uintptr_t begin_( reinterpret_cast<std::uintptr_t>( blockData( mBlock ) ) );
+				const std::uintptr_t address_( ( begin_ + mBlock->mUsed + pAlignment - 1 ) & ~static_cast<std::uintptr_t>( pAlignment - 1 ) );
+
+				// Bump
+				if ( address_ + pSize <= begin_ + mBlock->mSize )
+				{
+					mBlock->mUsed = address_ + pSize - begin_;
+					return( reinterpret_cast<void*>( address_ ) );
+				}
+
+			}
+
+			// New block, with space for alignment
+			addBlock( pSize + pAlignment );
+
+			// Allocate from new block
+			return( allocate( pSize, pAlignment ) );
+
+		}
+
+		/*
+		 * Constructs object in arena memory.
+		 *
+		 * @param pArgs - object constructor arguments.
+		 * @return - arena_ptr, valid until #reset.
+		 * @throws - std::bad_alloc, or object constructor exception.
+		*/
+		template <typename T, typename... Args>
+		arena_ptr<T> make( Args&&... pArgs )
+		{
+
+			// Trivial objects are not tracked
+			if ( std::is_trivially_destructible<T>::value )
+				return( arena_ptr<T>( new( allocate( sizeof( T ), alignof( T ) ) ) T( std::forward<Args>( pArgs )... ) ) );
+
+			// Reserve destructor record before object, so it can't fail after construction
+			arena_destructor *const record_lp( static_cast<arena_destructor*>( allocate( sizeof( arena_destructor ), alignof( arena_destructor ) ) ) );
+
+			// Construct Object
+			T *const object_lp( new( allocate( sizeof( T ), alignof( T ) ) ) T( std::forward<Args>( pArgs )... ) );
+
+			// Register destructor
+			record_lp->mNext = mDestructors;
+			record_lp->mObject = object_lp;
+			record_lp->mDestroy = &destroy<T>;
+			mDestructors = record_lp;
+
+			// Return result
+			return( arena_ptr<T>( object_lp ) );
+
+		}
+
+		/*
+		 * Moves object out of arena to the heap, to share it with fast_ptr.
+		 *
+		 * (?) Moved-from object stays in arena & destroyed on #reset.
+		 *
+		 * @param pObject - arena object, not null.
+		 * @return - fast_ptr with a new object instance.
+		 * @throws - std::bad_alloc, or object move-constructor exception.
+		*/
+		template <typename T>
+		fast_ptr<T> promote( const arena_ptr<T> & pObject )
+		{ return( fast_ptr<T>( new T( std::move( pObject.getRef( ) ) ) ) ); }
+
+		/*
+		 * Destroys all objects & releases memory.
+		 *
+		 * (?) First block is kept for reuse.
+		 * (!) All arena_ptr instances become invalid.
+		*/
+		void reset( ) noexcept
+		{
+
+			// Destroy objects, in reverse order
+			while ( mDestructors != nullptr )
+			{
+				mDestructors->mDestroy( mDestructors->mObject );
+				mDestructors = mDestructors->mNext;
+			}
+
+			// Cancel
+			if ( mBlock == nullptr )
+				return;
+
+			// Release blocks, except oldest one
+			while ( mBlock->mNext != nullptr )
+			{
+				arena_block *const next_lp( mBlock->mNext );
+				::operator delete( mBlock );
+				mBlock = next_lp;
+			}
+
+			// Rewind
+			mBlock->mUsed = 0;
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_ARENA_HXX_
@@ -0,0 +1,172 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include iostream
+#include <iostream>
+
+// Include stdlib
+#include <cstdlib>
+
+// Include std::size_t
+#include <cstddef>
+
+// Include std::chrono
+#include <chrono>
+
+// Include std::thread
+#include <thread>
+
+// Include std::vector
+#include <vector>
+
+// Include placement new
+#include <new>
+
+// Include rel_ptr_fields
+#include "../ptr_layout.hxx"
+
+// Misaligned atomics are supported (slowly) only by x86
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+#define _C0DE4UN_BENCHMARK_PACKED_
+#endif // x86
+
+/*
+ * Increases counters of neighbour entries from different threads, same as
+ * neighbour registry entries, used by different threads.
+ *
+ * @param pEntries - contiguous entries, one per thread.
+ * @param pThreads - number of threads.
+ * @param pIterations - increments per thread.
+ * @return - nanoseconds per increment.
+*/
+template <c0de4un::ptr_layout L>
+static double neighbours_test( c0de4un::rel_ptr_fields<void, L> *const pEntries, const unsigned int pThreads, const std::size_t pIterations )
+{
+
+	// Start
+	const std::chrono::steady_clock::time_point start_( std::chrono::steady_clock::now( ) );
+
+	// Run threads
+	std::vector<std::thread> threads_;
+	for ( unsigned int i = 0; i < pThreads; i++ )
+	{
+		threads_.emplace_back( [pEntries, i, pIterations]( )
+		{
+			for ( std::size_t j = 0; j < pIterations; j++ )
+				pEntries[i].mCounter++;
+		} );
+	}
+
+	// Wait
+	for ( std::thread & thread_lr : threads_ )
+		thread_lr.join( );
+
+	// Return result
+	const std::chrono::nanoseconds time_( std::chrono::steady_clock::now( ) - start_ );
+	return( static_cast<double>( time_.count( ) ) / static_cast<double>( pIterations ) );
+
+}
+
+/*
+ * Increases counter of single entry from one thread.
+ *
+ * @param pEntry - entry.
+ * @param pIterations - increments.
+ * @return - nanoseconds per increment.
+*/
+template <c0de4un::ptr_layout L>
+static double single_test( c0de4un::rel_ptr_fields<void, L> & pEntry, const std::size_t pIterations )
+{
+
+	// Start
+	const std::chrono::steady_clock::time_point start_( std::chrono::steady_clock::now( ) );
+
+	// Increase
+	for ( std::size_t i = 0; i < pIterations; i++ )
+		pEntry.mCounter++;
+
+	// Return result
+	const std::chrono::nanoseconds time_( std::chrono::steady_clock::now( ) - start_ );
+	return( static_cast<double>( time_.count( ) ) / static_cast<double>( pIterations ) );
+
+}
+
+/*
+ * Runs tests for the given layout & prints results.
+ *
+ * @param pName - layout name.
+ * @param pThreads - number of threads.
+ * @param pIterations - increments per thread.
+*/
+template <c0de4un::ptr_layout L>
+static void layout_test( const char *const pName, const unsigned int pThreads, const std::size_t pIterations )
+{
+
+	// Entry type
+	using entry_t = c0de4un::rel_ptr_fields<void, L>;
+
+	// Cache-line aligned memory, entries are contiguous (as in array), followed by one line for split entry
+	const std::size_t size_( sizeof( entry_t ) * pThreads + c0de4un::CACHE_LINE_SIZE * 4 );
+	std::vector<char> memory_( size_ );
+	const std::size_t offset_( c0de4un::CACHE_LINE_SIZE - reinterpret_cast<std::size_t>( memory_.data( ) ) % c0de4un::CACHE_LINE_SIZE );
+	entry_t *const entries_lp( reinterpret_cast<entry_t*>( memory_.data( ) + offset_ ) );
+	for ( unsigned int i = 0; i < pThreads; i++ )
+		new( entries_lp + i ) entry_t( );
+
+	// Entry, which counter crosses cache-line (only if packed, for example in a packed user structure)
+	const std::size_t lines_( ( sizeof( entry_t ) * pThreads ) / c0de4un::CACHE_LINE_SIZE + 2 );
+	entry_t *const split_lp( alignof( entry_t ) == 1
+		? new( memory_.data( ) + offset_ + lines_ * c0de4un::CACHE_LINE_SIZE - 2 ) entry_t( )
+		: nullptr );
+
+	// Print
+	std::cout << pName << ": size=" << sizeof( entry_t ) << ", alignment=" << alignof( entry_t )
+		<< ", memory per " << pThreads << " entries=" << sizeof( entry_t ) * pThreads << std::endl;
+	std::cout << "\tsingle thread, aligned counter: " << single_test<L>( entries_lp[0], pIterations ) << " ns/op" << std::endl;
+	// (!) Split locks can be trapped & rate-limited by OS (Linux split_lock_detect), so less iterations are used
+	if ( split_lp != nullptr )
+		std::cout << "\tsingle thread, split counter: " << single_test<L>( *split_lp, pIterations / 10000 + 1 ) << " ns/op" << std::endl;
+	std::cout << "\t" << pThreads << " threads, neighbour entries: " << neighbours_test<L>( entries_lp, pThreads, pIterations ) << " ns/op" << std::endl;
+
+}
+
+/*
+ * MAIN
+ *
+ * Usage: layout_benchmark [iterations] [threads]
+*/
+int main( int argc, char ** argv )
+{
+
+	// Arguments
+	const std::size_t iterations_( argc > 1 ? std::strtoul( argv[1], nullptr, 10 ) : 10000000 );
+	unsigned int threads_( argc > 2 ? static_cast<unsigned int>( std::strtoul( argv[2], nullptr, 10 ) ) : std::thread::hardware_concurrency( ) );
+	if ( threads_ < 2 )
+		threads_ = 2;
+	if ( threads_ > 16 )
+		threads_ = 16;
+
+	// Print
+	std::cout << "Layout benchmark, iterations=" << iterations_ << ", threads=" << threads_ << std::endl;
+
+#ifdef _C0DE4UN_BENCHMARK_PACKED_
+	// Packed
+	layout_test<c0de4un::ptr_layout::PACKED>( "PACKED", threads_, iterations_ );
+#else
+	std::cout << "PACKED: skipped, misaligned atomics are not supported" << std::endl;
+#endif // _C0DE4UN_BENCHMARK_PACKED_
+
+	// Aligned
+	layout_test<c0de4un::ptr_layout::ALIGNED>( "ALIGNED", threads_, iterations_ );
+
+	// Cache-line
+	layout_test<c0de4un::ptr_layout::CACHE_LINE>( "CACHE_LINE", threads_, iterations_ );
+
+	// Return OK
+	return( 0 );
+
+}
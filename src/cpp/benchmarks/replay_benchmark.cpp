@@ -0,0 +1,421 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include iostream
+#include <iostream>
+
+// Include std::ifstream
+#include <fstream>
+
+// Include stdlib
+#include <cstdlib>
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::uint64_t
+#include <cstdint>
+
+// Include std::chrono
+#include <chrono>
+
+// Include std::thread
+#include <thread>
+
+// Include std::atomic
+#include <atomic>
+
+// Include std::vector
+#include <vector>
+
+// Include std::sort, std::lower_bound
+#include <algorithm>
+
+// Include std::shared_ptr
+#include <memory>
+
+// Include trace_record
+#include "../ptr_trace.hxx"
+
+// Include fast_ptr
+#include "../fast_ptr.hxx"
+
+// Include rel_ptr
+#include "../rel_ptr.hpp"
+
+// Include trel_ptr
+#include "../typeless_rel_ptr.hpp"
+
+/* Replayed object */
+struct replay_object
+{
+
+	/* Payload */
+	std::uint64_t mValue;
+
+};
+
+/* Operations of single thread */
+using replay_thread = std::vector<c0de4un::trace_record>;
+
+/* fast_ptr adaptor */
+struct fast_ptr_replay
+{
+
+	/* Pointer */
+	using pointer_t = c0de4un::fast_ptr<replay_object>;
+
+	/* Name */
+	static const char *const name( )
+	{ return( "fast_ptr" ); }
+
+	/* Creates object */
+	static pointer_t create( )
+	{ return( pointer_t( new replay_object( ) ) ); }
+
+	/* Copies pointer */
+	static pointer_t copy( pointer_t & pPointer )
+	{ return( pointer_t( pPointer ) ); }
+
+	/* Searches pointer by object address. Copy, fast_ptr has no registry. */
+	static pointer_t lookup( pointer_t & pPointer )
+	{ return( pointer_t( pPointer ) ); }
+
+	/* Releases caches */
+	static void shutdown( )
+	{
+	}
+
+};
+
+/* rel_ptr adaptor */
+struct rel_ptr_replay
+{
+
+	/* Pointer */
+	using pointer_t = c0de4un::rel_ptr<replay_object>;
+
+	/* Name */
+	static const char *const name( )
+	{ return( "rel_ptr" ); }
+
+	/* Creates object */
+	static pointer_t create( )
+	{ return( pointer_t( new replay_object( ) ) ); }
+
+	/* Copies pointer */
+	static pointer_t copy( pointer_t & pPointer )
+	{ return( pointer_t( pPointer ) ); }
+
+	/* Searches pointer by object address */
+	static pointer_t lookup( pointer_t & pPointer )
+	{ return( pointer_t( pPointer.get( ) ) ); }
+
+	/* Releases caches */
+	static void shutdown( )
+	{ pointer_t::shutdown( ); }
+
+};
+
+/* trel_ptr adaptor */
+struct trel_ptr_replay
+{
+
+	/* Pointer */
+	using pointer_t = c0de4un::trel_ptr<replay_object>;
+
+	/* Name */
+	static const char *const name( )
+	{ return( "trel_ptr" ); }
+
+	/* Creates object */
+	static pointer_t create( )
+	{ return( pointer_t( new replay_object( ) ) ); }
+
+	/* Copies pointer */
+	static pointer_t copy( pointer_t & pPointer )
+	{ return( pointer_t( pPointer ) ); }
+
+	/* Searches pointer by object address */
+	static pointer_t lookup( pointer_t & pPointer )
+	{ return( pointer_t( pPointer.get( ) ) ); }
+
+	/* Releases caches */
+	static void shutdown( )
+	{ c0de4un::typeless_rel_ptr_shutdown( ); }
+
+};
+
+/* std::shared_ptr adaptor */
+struct shared_ptr_replay
+{
+
+	/* Pointer */
+	using pointer_t = std::shared_ptr<replay_object>;
+
+	/* Name */
+	static const char *const name( )
+	{ return( "std::shared_ptr" ); }
+
+	/* Creates object */
+	static pointer_t create( )
+	{ return( std::make_shared<replay_object>( ) ); }
+
+	/* Copies pointer */
+	static pointer_t copy( pointer_t & pPointer )
+	{ return( pPointer ); }
+
+	/* Searches pointer by object address. Copy, shared_ptr has no registry. */
+	static pointer_t lookup( pointer_t & pPointer )
+	{ return( pPointer ); }
+
+	/* Releases caches */
+	static void shutdown( )
+	{
+	}
+
+};
+
+/*
+ * Reads operations, written by c0de4un::ptr_trace::save.
+ *
+ * (?) Sequence numbers are renumbered from 0, without gaps.
+ *
+ * @param pInput - input stream.
+ * @param pThreads - threads operations, to fill.
+ * @param pObjects - max object ID, to set.
+ * @return - false if format is not valid.
+*/
+static bool load_trace( std::istream & pInput, std::vector<replay_thread> & pThreads, std::uint32_t & pObjects )
+{
+
+	// Header
+	std::uint32_t magic_( 0 ), version_( 0 ), threads_( 0 );
+	pInput.read( reinterpret_cast<char*>( &magic_ ), sizeof( magic_ ) );
+	pInput.read( reinterpret_cast<char*>( &version_ ), sizeof( version_ ) );
+	pInput.read( reinterpret_cast<char*>( &threads_ ), sizeof( threads_ ) );
+	if ( !pInput || magic_ != c0de4un::TRACE_MAGIC || version_ != c0de4un::TRACE_VERSION )
+		return( false );
+
+	// Threads
+	pThreads.assign( threads_, replay_thread( ) );
+	pObjects = 0;
+	std::vector<std::uint64_t> sequences_;
+	for ( replay_thread & thread_lr : pThreads )
+	{
+
+		// Count
+		std::uint32_t count_( 0 );
+		pInput.read( reinterpret_cast<char*>( &count_ ), sizeof( count_ ) );
+
+		// Records
+		for ( std::uint32_t i = 0; i < count_ && pInput; i++ )
+		{
+			c0de4un::trace_record record_{ 0, 0, c0de4un::trace_op::CREATE };
+			pInput.read( reinterpret_cast<char*>( &record_.mSequence ), sizeof( record_.mSequence ) );
+			pInput.read( reinterpret_cast<char*>( &record_.mObject ), sizeof( record_.mObject ) );
+			pInput.read( reinterpret_cast<char*>( &record_.mOperation ), sizeof( record_.mOperation ) );
+			if ( record_.mOperation > c0de4un::trace_op::FREE )
+				return( false );
+			thread_lr.push_back( record_ );
+			sequences_.push_back( record_.mSequence );
+			pObjects = std::max( pObjects, record_.mObject );
+		}
+
+		if ( !pInput )
+			return( false );
+
+	}
+
+	// Renumber
+	std::sort( sequences_.begin( ), sequences_.end( ) );
+	for ( replay_thread & thread_lr : pThreads )
+	{
+		for ( c0de4un::trace_record & record_lr : thread_lr )
+			record_lr.mSequence = static_cast<std::uint64_t>( std::lower_bound( sequences_.begin( ), sequences_.end( ), record_lr.mSequence ) - sequences_.begin( ) );
+	}
+
+	// Return OK
+	return( true );
+
+}
+
+/*
+ * Executes operation.
+ *
+ * @param pRecord - operation.
+ * @param pObjects - pointers instances, by object ID.
+*/
+template <typename A>
+static void replay_operation( const c0de4un::trace_record & pRecord, std::vector<std::vector<typename A::pointer_t>> & pObjects )
+{
+
+	// Object instances
+	std::vector<typename A::pointer_t> & instances_lr( pObjects[pRecord.mObject] );
+
+	switch ( pRecord.mOperation )
+	{
+	case c0de4un::trace_op::CREATE:
+		instances_lr.push_back( A::create( ) );
+		break;
+	case c0de4un::trace_op::COPY:
+	case c0de4un::trace_op::LOOKUP:
+		// Object, created before recording
+		if ( instances_lr.empty( ) )
+			instances_lr.push_back( A::create( ) );
+		else if ( pRecord.mOperation == c0de4un::trace_op::COPY )
+			instances_lr.push_back( A::copy( instances_lr.back( ) ) );
+		else
+			instances_lr.push_back( A::lookup( instances_lr.back( ) ) );
+		break;
+	case c0de4un::trace_op::RELEASE:
+		if ( !instances_lr.empty( ) )
+			instances_lr.pop_back( );
+		break;
+	case c0de4un::trace_op::FREE:
+		break;
+	}
+
+}
+
+/*
+ * Replays operations with the original interleaving: each operation waits,
+ * until all operations with lower sequence are executed.
+ *
+ * @param pThreads - threads operations.
+ * @param pObjects - max object ID.
+ * @return - milliseconds.
+*/
+template <typename A>
+static double replay_test( const std::vector<replay_thread> & pThreads, const std::uint32_t pObjects )
+{
+
+	// Pointers instances, by object ID. Accessed in sequence order only.
+	std::vector<std::vector<typename A::pointer_t>> objects_( static_cast<std::size_t>( pObjects ) + 1 );
+
+	// Next operation
+	std::atomic<std::uint64_t> sequence_( 0 );
+
+	// Start
+	const std::chrono::steady_clock::time_point start_( std::chrono::steady_clock::now( ) );
+
+	// Run threads
+	std::vector<std::thread> threads_;
+	for ( const replay_thread & thread_lr : pThreads )
+	{
+		const replay_thread *const records_lp( &thread_lr );
+		threads_.emplace_back( [records_lp, &objects_, &sequence_]( )
+		{
+			for ( const c0de4un::trace_record & record_lr : *records_lp )
+			{
+
+				// Wait for turn
+				while ( sequence_.load( std::memory_order_acquire ) != record_lr.mSequence )
+					std::this_thread::yield( );
+
+				// Execute
+				replay_operation<A>( record_lr, objects_ );
+
+				// Next
+				sequence_.store( record_lr.mSequence + 1, std::memory_order_release );
+
+			}
+		} );
+	}
+
+	// Wait
+	for ( std::thread & thread_lr : threads_ )
+		thread_lr.join( );
+
+	// Release objects, alive at the end of trace
+	objects_.clear( );
+
+	// Return result
+	const std::chrono::duration<double, std::milli> time_( std::chrono::steady_clock::now( ) - start_ );
+	A::shutdown( );
+	return( time_.count( ) );
+
+}
+
+/*
+ * Replays trace & prints result.
+ *
+ * @param pThreads - threads operations.
+ * @param pObjects - max object ID.
+ * @param pRepeats - number of replays, best time is printed.
+*/
+template <typename A>
+static void replay( const std::vector<replay_thread> & pThreads, const std::uint32_t pObjects, const unsigned int pRepeats )
+{
+
+	// Registry pointers print every operation, silence them
+	std::cout.setstate( std::ios_base::badbit );
+
+	// Replay
+	double best_( 0.0 );
+	for ( unsigned int i = 0; i < pRepeats; i++ )
+	{
+		const double time_( replay_test<A>( pThreads, pObjects ) );
+		if ( i == 0 || time_ < best_ )
+			best_ = time_;
+	}
+
+	// Print
+	std::cout.clear( );
+	std::cout << A::name( ) << ": " << best_ << " ms" << std::endl;
+
+}
+
+/*
+ * MAIN
+ *
+ * Usage: replay_benchmark <trace-file> [repeats]
+ *
+ * (?) Trace is recorded by a process, built with _C0DE4UN_POINTERS_TRACE_ENABLED_,
+ * see c0de4un::ptr_trace::save.
+*/
+int main( int argc, char ** argv )
+{
+
+	// Usage
+	if ( argc < 2 )
+	{
+		std::cout << "Usage: replay_benchmark <trace-file> [repeats]" << std::endl;
+		return( 0 );
+	}
+
+	// Load
+	std::ifstream input_( argv[1], std::ios::binary );
+	std::vector<replay_thread> threads_;
+	std::uint32_t objects_( 0 );
+	if ( !input_ || !load_trace( input_, threads_, objects_ ) )
+	{
+		std::cerr << "Invalid trace file: " << argv[1] << std::endl;
+		return( 1 );
+	}
+
+	// Arguments
+	unsigned int repeats_( argc > 2 ? static_cast<unsigned int>( std::strtoul( argv[2], nullptr, 10 ) ) : 3 );
+	if ( repeats_ < 1 )
+		repeats_ = 1;
+
+	// Print
+	std::size_t operations_( 0 );
+	for ( const replay_thread & thread_lr : threads_ )
+		operations_ += thread_lr.size( );
+	std::cout << "Replay benchmark, threads=" << threads_.size( ) << ", operations=" << operations_ << ", objects=" << objects_ << std::endl;
+
+	// Replay
+	replay<fast_ptr_replay>( threads_, objects_, repeats_ );
+	replay<rel_ptr_replay>( threads_, objects_, repeats_ );
+	replay<trel_ptr_replay>( threads_, objects_, repeats_ );
+	replay<shared_ptr_replay>( threads_, objects_, repeats_ );
+
+	// Return OK
+	return( 0 );
+
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_BORROW_TRACKER_HXX_
+#define _C0DE4UN_BORROW_TRACKER_HXX_
+
+// Borrows are validated in Debug builds
+#if defined( DEBUG ) && !defined( _C0DE4UN_POINTERS_BORROW_CHECK_ENABLED_ )
+#define _C0DE4UN_POINTERS_BORROW_CHECK_ENABLED_
+#endif // DEBUG
+
+#ifdef _C0DE4UN_POINTERS_BORROW_CHECK_ENABLED_ // Borrow Check Mode
+
+// Include std::size_t
+#include <cstddef>
+
+// Include std::abort
+#include <cstdlib>
+
+// Include std::unordered_map
+#include <unordered_map>
+
+// Include std::mutex, std::lock_guard
+#include <mutex>
+
+// Include std::cerr
+#include <iostream>
+
+// Include ptr_registry
+#include "ptr_registry.hxx"
+
+/* Registers borrow of the object, see c0de4un::borrow_tracker */
+#define _C0DE4UN_POINTERS_BORROW_( pObject ) ::c0de4un::borrow_tracker::borrow( pObject )
+
+/* Checks, that released object is not borrowed, see c0de4un::borrow_tracker */
+#define _C0DE4UN_POINTERS_BORROW_CHECK_( pObject ) ::c0de4un::borrow_tracker::check( pObject )
+
+#else
+
+/* Borrow Check Mode disabled */
+#define _C0DE4UN_POINTERS_BORROW_( pObject ) ( void )0
+
+/* Borrow Check Mode disabled */
+#define _C0DE4UN_POINTERS_BORROW_CHECK_( pObject ) ( void )0
+
+#endif // _C0DE4UN_POINTERS_BORROW_CHECK_ENABLED_
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_BORROW_TRACKER_DECL_
+
+#ifdef _C0DE4UN_POINTERS_BORROW_CHECK_ENABLED_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * borrow_tracker - counts borrowed_ptr instances by object (Borrow Check Mode).
+	 *
+	 * Enabled in Debug builds (DEBUG), or by _C0DE4UN_POINTERS_BORROW_CHECK_ENABLED_.
+	 * Owning pointers call #check before object is deleted, & program is aborted,
+	 * if object is still borrowed: borrowed_ptr outlived all strong references.
+	 *
+	 * (?) Thread-locked, for debugging only.
+	 *
+	 * @thread_safety - thread-safe.
+	 * @version 0.1.0
+	*/
+	class borrow_tracker final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Thread-lock */
+		std::mutex mMutex;
+
+		/* Number of borrows, by object address */
+		std::unordered_map<const void*, std::size_t> mBorrows;
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Registers borrow of the object.
+		 *
+		 * @param pObject - object address, ignored if null.
+		 * @throws - std::bad_alloc, mutex.
+		*/
+		static void borrow( const void *const pObject )
+		{
+
+			// Cancel
+			if ( pObject == nullptr )
+				return;
+
+			// Count
+			borrow_tracker & tracker_lr( ptr_registry<borrow_tracker>::get( ) );
+			std::lock_guard<std::mutex> lock_( tracker_lr.mMutex );
+			tracker_lr.mBorrows[pObject]++;
+
+		}
+
+		/*
+		 * Unregisters borrow of the object.
+		 *
+		 * @param pObject - object address, ignored if null.
+		*/
+		static void unborrow( const void *const pObject ) noexcept
+		{
+
+			// Cancel
+			if ( pObject == nullptr || !ptr_registry<borrow_tracker>::isInitialized( ) )
+				return;
+
+			try
+			{
+
+				// Count
+				borrow_tracker & tracker_lr( ptr_registry<borrow_tracker>::get( ) );
+				std::lock_guard<std::mutex> lock_( tracker_lr.mMutex );
+				std::unordered_map<const void*, std::size_t>::iterator borrow_( tracker_lr.mBorrows.find( pObject ) );
+				if ( borrow_ != tracker_lr.mBorrows.end( ) && --borrow_->second < 1 )
+					tracker_lr.mBorrows.erase( borrow_ );
+
+			}
+			catch ( ... )
+			{
+				// Borrow Check Mode is for debugging, ignore
+			}
+
+		}
+
+		/*
+		 * Aborts program, if object is borrowed. Called before object is deleted.
+		 *
+		 * @param pObject - object address.
+		*/
+		static void check( const void *const pObject ) noexcept
+		{
+
+			// Cancel, nothing borrowed yet
+			if ( pObject == nullptr || !ptr_registry<borrow_tracker>::isInitialized( ) )
+				return;
+
+			// Search
+			std::size_t borrows_( 0 );
+			try
+			{
+				borrow_tracker & tracker_lr( ptr_registry<borrow_tracker>::get( ) );
+				std::lock_guard<std::mutex> lock_( tracker_lr.mMutex );
+				std::unordered_map<const void*, std::size_t>::const_iterator borrow_( tracker_lr.mBorrows.find( pObject ) );
+				if ( borrow_ != tracker_lr.mBorrows.cend( ) )
+					borrows_ = borrow_->second;
+			}
+			catch ( ... )
+			{
+				// Borrow Check Mode is for debugging, ignore
+			}
+
+			// Dangling borrowed_ptr
+			if ( borrows_ > 0 )
+			{
+				std::cerr << "borrowed_ptr: object " << pObject << " released while borrowed " << borrows_ << " time(s)" << std::endl;
+				std::abort( );
+			}
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // _C0DE4UN_POINTERS_BORROW_CHECK_ENABLED_
+
+#endif // !_C0DE4UN_BORROW_TRACKER_HXX_
@@ -0,0 +1,198 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_BORROWED_PTR_HXX_
+#define _C0DE4UN_BORROWED_PTR_HXX_
+
+// Include std::nullptr_t
+#include <cstddef>
+
+// Include std::declval
+#include <utility>
+
+// Include borrow_tracker
+#include "borrow_tracker.hxx"
+
+// Include fast_ptr
+#include "fast_ptr.hxx"
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_BORROWED_PTR_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * borrowed_ptr - non-owning pointer, for temporary access (parameters).
+	 *
+	 * Constructed from fast_ptr, rel_ptr, trel_ptr, compressed_ptr, cow_ptr (as
+	 * borrowed_ptr<const T>), or any pointer with operator->, without counters &
+	 * thread-locks. Size of the raw pointer & trivially copyable in Release builds.
+	 *
+	 * (!) Strong reference must outlive borrowed_ptr. In Debug builds (Borrow
+	 * Check Mode) borrows are counted & releasing borrowed object aborts program.
+	 * (!) Don't borrow handle_ptr: slot_map moves objects on insert & erase.
+	 *
+	 * @version 0.1.0
+	*/
+	template <typename T>
+	class borrowed_ptr final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Borrowed object */
+		T * mObject;
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructors & Destructor
+		// ===========================================================
+
+		/* borrowed_ptr constructor, null */
+		borrowed_ptr( std::nullptr_t = nullptr ) noexcept
+			: mObject( nullptr )
+		{
+		}
+
+		/*
+		 * borrowed_ptr constructor
+		 *
+		 * @param pObject - object, owned by other pointer.
+		 * @throws - std::bad_alloc, in Borrow Check Mode.
+		*/
+		explicit borrowed_ptr( T *const pObject )
+			: mObject( pObject )
+		{
+			_C0DE4UN_POINTERS_BORROW_( mObject );
+		}
+
+		/*
+		 * borrowed_ptr constructor, borrows object of the fast_ptr.
+		 *
+		 * @param pPointer - owning pointer.
+		 * @throws - std::bad_alloc, in Borrow Check Mode.
+		*/
+		borrowed_ptr( const fast_ptr<T> & pPointer )
+			: mObject( pPointer.getPtr( ) )
+		{
+			_C0DE4UN_POINTERS_BORROW_( mObject );
+		}
+
+		/* @deleted borrowed_ptr constructor, temporary fast_ptr releases object */
+		borrowed_ptr( fast_ptr<T> && ) = delete;
+
+		/*
+		 * borrowed_ptr constructor, borrows object of the pointer.
+		 *
+		 * @param pPointer - owning pointer, with operator->.
+		 * @throws - std::bad_alloc, in Borrow Check Mode.
+		*/
+		template <typename P, typename = decltype( std::declval<P&>( ).operator->( ) )>
+		borrowed_ptr( P & pPointer )
+			: mObject( pPointer.operator->( ) )
+		{
+			_C0DE4UN_POINTERS_BORROW_( mObject );
+		}
+
+#ifdef _C0DE4UN_POINTERS_BORROW_CHECK_ENABLED_
+		/* borrowed_ptr const copy constructor */
+		borrowed_ptr( const borrowed_ptr<T> & pOther )
+			: mObject( pOther.mObject )
+		{
+			borrow_tracker::borrow( mObject );
+		}
+
+		/* borrowed_ptr const copy assignment operator */
+		borrowed_ptr<T> & operator=( const borrowed_ptr<T> & pOther )
+		{
+
+			borrow_tracker::borrow( pOther.mObject );
+			borrow_tracker::unborrow( mObject );
+			mObject = pOther.mObject;
+
+			// Return
+			return( *this );
+
+		}
+
+		/* borrowed_ptr destructor */
+		~borrowed_ptr( ) noexcept
+		{ borrow_tracker::unborrow( mObject ); }
+#endif // _C0DE4UN_POINTERS_BORROW_CHECK_ENABLED_
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/* Returns 'raw-pointer' */
+		T *const get( ) const noexcept
+		{ return( mObject ); }
+
+		/* Returns 'reference'. (!) Don't call on null-value. */
+		T & getRef( ) const noexcept
+		{ return( *mObject ); }
+
+		// ===========================================================
+		// Operators
+		// ===========================================================
+
+		/* Returns 'raw-pointer' to the object instance, can be null. Same as #get. */
+		T *const operator*( ) const noexcept
+		{ return( mObject ); }
+
+		/* Pointer address access operator */
+		T *const operator->( ) const noexcept
+		{ return( mObject ); }
+
+		/* Returns true if 'pointer' is nullptr */
+		const bool operator==( std::nullptr_t ) const noexcept
+		{ return( mObject == nullptr ); }
+
+		/* Returns true if 'pointer' is not nullptr */
+		const bool operator!=( std::nullptr_t ) const noexcept
+		{ return( mObject != nullptr ); }
+
+		/* Returns true if both borrow same object */
+		const bool operator==( const borrowed_ptr<T> & pOther ) const noexcept
+		{ return( mObject == pOther.mObject ); }
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	/* borrowed_ptr stores only 'raw-pointer', borrows are counted by object */
+	template <typename T>
+	struct is_trivially_relocatable<borrowed_ptr<T>> : public std::true_type
+	{
+	};
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_BORROWED_PTR_HXX_
@@ -0,0 +1,684 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_COMPRESSED_PTR_HXX_
+#define _C0DE4UN_COMPRESSED_PTR_HXX_
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::uint32_t, std::uint64_t
+#include <cstdint>
+
+// Include std::abort
+#include <cstdlib>
+
+// Include std::fputs
+#include <cstdio>
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_ // Multithreading Mode
+// Include std::atomic
+#include <atomic>
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+// Include std::bad_alloc, placement new
+#include <new>
+
+// Include std::forward
+#include <utility>
+
+// Include std::mutex, std::lock_guard
+#include <mutex>
+
+// Include std::vector
+#include <vector>
+
+// Include std::multimap
+#include <map>
+
+#ifdef _WIN32
+// Include VirtualAlloc, VirtualFree
+#include <windows.h>
+#else
+// Include mmap, mprotect, munmap
+#include <sys/mman.h>
+#endif // _WIN32
+
+// Include _C0DE4UN_POINTERS_BORROW_CHECK_
+#include "fast_ptr.hxx"
+
+// Include ptr_registry
+#include "ptr_registry.hxx"
+
+// Reserved address range of the compressed heap (bytes), up to 32 GiB
+#ifndef _C0DE4UN_COMPRESSED_HEAP_SIZE_
+#define _C0DE4UN_COMPRESSED_HEAP_SIZE_ 0x800000000ull
+#endif // !_C0DE4UN_COMPRESSED_HEAP_SIZE_
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_COMPRESSED_PTR_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * Type-Alias for compressed_ptr instances counter.
+	 *
+	 * (?) 32-bit: counter shares 8-byte granule with the object, so it usually
+	 * takes no more memory, than 16-bit counter_t with padding.
+	*/
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+	using compressed_counter_t = std::atomic<std::uint32_t>;
+#else
+	using compressed_counter_t = std::uint32_t;
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+	/*
+	 * compressed_heap - reserved address range, addressed by 32-bit scaled offsets.
+	 *
+	 * Memory is allocated in 8-byte granules, so 32-bit offset covers 32 GiB.
+	 * Range is reserved once (no physical memory) & committed by parts, when
+	 * bump allocation reaches them. Released blocks are reused, by size.
+	 * Offset 0 is never allocated, it's null.
+	 *
+	 * (?) Process-wide, see #get. Base address is stored in plain static variable,
+	 * so decompression is a single shift & add.
+	 *
+	 * @thread_safety - allocation & release are thread-locked.
+	 * @version 0.1.0
+	*/
+	class compressed_heap final
+	{
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constants
+		// ===========================================================
+
+		/* Granule size (bytes) & offset scale */
+		static constexpr std::size_t GRANULE_SIZE = 8;
+
+		/* log2 of the #GRANULE_SIZE */
+		static constexpr unsigned int GRANULE_SHIFT = 3;
+
+		/* Reserved range size (bytes) */
+		static constexpr std::uint64_t RESERVED_SIZE = _C0DE4UN_COMPRESSED_HEAP_SIZE_;
+
+		/* Committed at once (bytes) */
+		static constexpr std::size_t COMMIT_SIZE = 0x100000;
+
+		/* Blocks up to this number of granules are reused by exact size */
+		static constexpr std::uint32_t SMALL_GRANULES = 64;
+
+		static_assert( RESERVED_SIZE <= ( static_cast<std::uint64_t>( 1 ) << ( 32 + GRANULE_SHIFT ) ), "compressed_heap: 32-bit offsets address up to 32 GiB" );
+
+		static_assert( RESERVED_SIZE % COMMIT_SIZE == 0, "compressed_heap: reserved size must be multiple of COMMIT_SIZE" );
+
+		// -------------------------------------------------------- \\
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Thread-lock */
+		std::mutex mMutex;
+
+		/* First free granule after allocated ones */
+		std::uint64_t mTop;
+
+		/* Committed granules */
+		std::uint64_t mCommitted;
+
+		/* Released small blocks, by number of granules. Next block offset is stored in the block. */
+		std::vector<std::uint32_t> mSmallBlocks;
+
+		/* Released large blocks, by number of granules */
+		std::multimap<std::uint32_t, std::uint32_t> mLargeBlocks;
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/* Returns base address variable. Constant-initialized, no static constructor. */
+		static char *& base( ) noexcept
+		{
+
+			// Base
+			static char * base_( nullptr );
+
+			// Return result
+			return( base_ );
+
+		}
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Commits granules, up to the given one.
+		 *
+		 * @param pTop - granule, after the last required one.
+		 * @throws - std::bad_alloc.
+		*/
+		void commit( const std::uint64_t pTop )
+		{
+
+			// Committed
+			if ( pTop <= mCommitted )
+				return;
+
+			// Range to commit
+			const std::uint64_t granules_( COMMIT_SIZE >> GRANULE_SHIFT );
+			const std::uint64_t top_( ( pTop + granules_ - 1 ) / granules_ * granules_ );
+			char *const address_lp( base( ) + ( mCommitted << GRANULE_SHIFT ) );
+			const std::size_t size_( static_cast<std::size_t>( ( top_ - mCommitted ) << GRANULE_SHIFT ) );
+
+			// Commit
+#ifdef _WIN32
+			if ( VirtualAlloc( address_lp, size_, MEM_COMMIT, PAGE_READWRITE ) == nullptr )
+				throw std::bad_alloc( );
+#else
+			if ( mprotect( address_lp, size_, PROT_READ | PROT_WRITE ) != 0 )
+				throw std::bad_alloc( );
+#endif // _WIN32
+
+			mCommitted = top_;
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructor & destructor
+		// ===========================================================
+
+		/*
+		 * compressed_heap constructor. Reserves address range.
+		 *
+		 * @throws - std::bad_alloc, if range can't be reserved, or other heap exists.
+		*/
+		compressed_heap( )
+			: mMutex( ),
+			mTop( 1 ),
+			mCommitted( 0 ),
+			mSmallBlocks( SMALL_GRANULES + 1, 0 ),
+			mLargeBlocks( )
+		{
+
+			// Single heap
+			if ( base( ) != nullptr )
+				throw std::bad_alloc( );
+
+			// Reserve
+#ifdef _WIN32
+			void *const base_lp( VirtualAlloc( nullptr, static_cast<std::size_t>( RESERVED_SIZE ), MEM_RESERVE, PAGE_NOACCESS ) );
+			if ( base_lp == nullptr )
+				throw std::bad_alloc( );
+#else
+			void *const base_lp( mmap( nullptr, static_cast<std::size_t>( RESERVED_SIZE ), PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 ) );
+			if ( base_lp == MAP_FAILED )
+				throw std::bad_alloc( );
+#endif // _WIN32
+
+			base( ) = static_cast<char*>( base_lp );
+
+		}
+
+		/* compressed_heap destructor. (!) All pointers must be released. */
+		~compressed_heap( ) noexcept
+		{
+
+			// Release range
+#ifdef _WIN32
+			VirtualFree( base( ), 0, MEM_RELEASE );
+#else
+			munmap( base( ), static_cast<std::size_t>( RESERVED_SIZE ) );
+#endif // _WIN32
+
+			base( ) = nullptr;
+
+		}
+
+		// ===========================================================
+		// Deleted
+		// ===========================================================
+
+		/* @deleted compressed_heap const copy constructor */
+		compressed_heap( const compressed_heap & ) = delete;
+
+		/* @deleted compressed_heap const copy assignment operator */
+		compressed_heap & operator=( const compressed_heap & ) = delete;
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/*
+		 * Returns process-wide heap, reserves range on first call.
+		 *
+		 * @throws - std::bad_alloc.
+		*/
+		static compressed_heap & get( )
+		{ return( ptr_registry<compressed_heap>::get( ) ); }
+
+		/* Returns address of the given offset. (!) Heap must exist. */
+		static void *const decompress( const std::uint32_t pOffset ) noexcept
+		{ return( base( ) + ( static_cast<std::uint64_t>( pOffset ) << GRANULE_SHIFT ) ); }
+
+		/* Returns offset of the given address, allocated by heap */
+		static const std::uint32_t compress( const void *const pAddress ) noexcept
+		{ return( static_cast<std::uint32_t>( ( static_cast<const char*>( pAddress ) - base( ) ) >> GRANULE_SHIFT ) ); }
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Allocates memory, 8-byte aligned.
+		 *
+		 * @param pSize - size (bytes).
+		 * @return - offset.
+		 * @throws - std::bad_alloc, if heap is full.
+		*/
+		const std::uint32_t allocate( const std::size_t pSize )
+		{
+
+			// Granules
+			const std::uint64_t granules_( pSize > 0 ? ( pSize + GRANULE_SIZE - 1 ) >> GRANULE_SHIFT : 1 );
+
+			// Lock
+			std::lock_guard<std::mutex> lock_( mMutex );
+
+			// Reuse small block
+			if ( granules_ <= SMALL_GRANULES )
+			{
+				std::uint32_t & head_lr( mSmallBlocks[static_cast<std::size_t>( granules_ )] );
+				if ( head_lr != 0 )
+				{
+					const std::uint32_t result_( head_lr );
+					head_lr = *static_cast<std::uint32_t*>( decompress( result_ ) );
+					return( result_ );
+				}
+			}
+			else
+			{// Reuse large block
+				std::multimap<std::uint32_t, std::uint32_t>::iterator block_( mLargeBlocks.find( static_cast<std::uint32_t>( granules_ ) ) );
+				if ( block_ != mLargeBlocks.end( ) )
+				{
+					const std::uint32_t result_( block_->second );
+					mLargeBlocks.erase( block_ );
+					return( result_ );
+				}
+			}
+
+			// Full
+			if ( mTop + granules_ > ( RESERVED_SIZE >> GRANULE_SHIFT ) )
+				throw std::bad_alloc( );
+
+			// Bump
+			commit( mTop + granules_ );
+			const std::uint32_t result_( static_cast<std::uint32_t>( mTop ) );
+			mTop += granules_;
+
+			// Return result
+			return( result_ );
+
+		}
+
+		/*
+		 * Releases memory, for reuse by blocks of the same size.
+		 *
+		 * @param pOffset - offset, returned by #allocate.
+		 * @param pSize - size (bytes), same as allocated.
+		*/
+		void deallocate( const std::uint32_t pOffset, const std::size_t pSize ) noexcept
+		{
+
+			// Granules
+			const std::uint64_t granules_( pSize > 0 ? ( pSize + GRANULE_SIZE - 1 ) >> GRANULE_SHIFT : 1 );
+
+			// Lock
+			std::lock_guard<std::mutex> lock_( mMutex );
+
+			// Small block
+			if ( granules_ <= SMALL_GRANULES )
+			{
+				std::uint32_t & head_lr( mSmallBlocks[static_cast<std::size_t>( granules_ )] );
+				*static_cast<std::uint32_t*>( decompress( pOffset ) ) = head_lr;
+				head_lr = pOffset;
+				return;
+			}
+
+			// Large block. (?) Lost, if there is no memory to store it.
+			try
+			{
+				mLargeBlocks.insert( std::make_pair( static_cast<std::uint32_t>( granules_ ), pOffset ) );
+			}
+			catch ( ... )
+			{
+			}
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	/*
+	 * compressed_ptr - shared pointer, stored as 32-bit offset in the compressed_heap.
+	 *
+	 * Counter & object are allocated together, in one heap block. Pointer is
+	 * 4 bytes, instead of 16 bytes of the fast_ptr (object & counter addresses).
+	 *
+	 * @version 0.1.0
+	*/
+	template <typename T>
+	class compressed_ptr final
+	{
+
+		static_assert( alignof( T ) <= compressed_heap::GRANULE_SIZE, "compressed_ptr: object alignment must not exceed 8 bytes" );
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Types
+		// ===========================================================
+
+		/* Heap block */
+		struct compressed_block
+		{
+
+			/* Instances counter */
+			compressed_counter_t mCounter;
+
+			/* Object */
+			T mObject;
+
+			/* compressed_block constructor */
+			template <typename... Args>
+			explicit compressed_block( Args&&... pArgs )
+				: mCounter( 1 ),
+				mObject( std::forward<Args>( pArgs )... )
+			{
+			}
+
+			/*
+			 * Adds instance.
+			 *
+			 * (!) Program is aborted, if counter would wrap to zero.
+			*/
+			void retain( ) noexcept
+			{
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+				std::uint32_t count_( mCounter.load( ) );
+				do
+				{
+					if ( count_ == UINT32_MAX )
+						overflow( );
+				}
+				while ( !mCounter.compare_exchange_weak( count_, count_ + 1 ) );
+#else
+				if ( mCounter == UINT32_MAX )
+					overflow( );
+				mCounter++;
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+			}
+
+			/* Aborts program, instances counter overflow */
+			[[noreturn]] static void overflow( ) noexcept
+			{
+				std::fputs( "compressed_ptr: instances counter overflow\n", stderr );
+				std::abort( );
+			}
+
+		};
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Block offset, 0 if null */
+		std::uint32_t mOffset;
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/* Returns block. (!) Don't call on null-value. */
+		compressed_block *const getBlock( ) const noexcept
+		{ return( static_cast<compressed_block*>( compressed_heap::decompress( mOffset ) ) ); }
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Decreases counter & deletes object, if last instance. Resets this instance. */
+		void release( ) noexcept
+		{
+
+			// Decrease counter
+			if ( mOffset != 0 )
+			{
+
+				// Block
+				compressed_block *const block_lp( getBlock( ) );
+
+				// Single (atomic) operation, so only one instance can see zero.
+				if ( --block_lp->mCounter < 1 )
+				{
+					_C0DE4UN_POINTERS_BORROW_CHECK_( &block_lp->mObject );
+					block_lp->~compressed_block( );
+					compressed_heap::get( ).deallocate( mOffset, sizeof( compressed_block ) );
+				}
+
+			}
+
+			// Reset
+			mOffset = 0;
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructors & Destructor
+		// ===========================================================
+
+		/* compressed_ptr default constructor, null */
+		compressed_ptr( ) noexcept
+			: mOffset( 0 )
+		{
+		}
+
+		/* compressed_ptr const copy constructor */
+		compressed_ptr( const compressed_ptr<T> & pOther ) noexcept
+			: mOffset( pOther.mOffset )
+		{
+
+			// Increase Pointers-Instances Counter
+			if ( mOffset != 0 )
+				getBlock( )->retain( );
+
+		}
+
+		/* compressed_ptr const copy operator */
+		compressed_ptr<T> & operator=( const compressed_ptr<T> & pOther ) noexcept
+		{
+
+			// Cancel if self-copy, or same object
+			if ( mOffset == pOther.mOffset )
+				return( *this );
+
+			// Increase Pointers-Instances Counter of the new object
+			if ( pOther.mOffset != 0 )
+				pOther.getBlock( )->retain( );
+
+			// Release previous object
+			release( );
+
+			// Copy value
+			mOffset = pOther.mOffset;
+
+			// Return
+			return( *this );
+
+		}
+
+		/* compressed_ptr move constructor */
+		compressed_ptr( compressed_ptr<T> && pOther ) noexcept
+			: mOffset( pOther.mOffset )
+		{
+			pOther.mOffset = 0;
+		}
+
+		/* compressed_ptr move assignment operator */
+		compressed_ptr<T> & operator=( compressed_ptr<T> && pOther ) noexcept
+		{
+
+			// Cancel if self-move
+			if ( this == &pOther )
+				return( *this );
+
+			// Release previous object
+			release( );
+
+			// Move value
+			mOffset = pOther.mOffset;
+			pOther.mOffset = 0;
+
+			// Return
+			return( *this );
+
+		}
+
+		/* compressed_ptr destructor */
+		~compressed_ptr( ) noexcept
+		{ release( ); }
+
+		// ===========================================================
+		// Methods & Operators
+		// ===========================================================
+
+		/*
+		 * Constructs object in the compressed_heap.
+		 *
+		 * @param pArgs - object constructor arguments.
+		 * @return - compressed_ptr.
+		 * @throws - std::bad_alloc, or object constructor exception.
+		*/
+		template <typename... Args>
+		static compressed_ptr<T> make( Args&&... pArgs )
+		{
+
+			// Allocate
+			compressed_heap & heap_lr( compressed_heap::get( ) );
+			const std::uint32_t offset_( heap_lr.allocate( sizeof( compressed_block ) ) );
+
+			// Construct
+			try
+			{
+				new( compressed_heap::decompress( offset_ ) ) compressed_block( std::forward<Args>( pArgs )... );
+			}
+			catch ( ... )
+			{
+				heap_lr.deallocate( offset_, sizeof( compressed_block ) );
+				throw;
+			}
+
+			// Return result
+			compressed_ptr<T> result_;
+			result_.mOffset = offset_;
+			return( result_ );
+
+		}
+
+		/* Releases stored object, 'pointer' becomes null */
+		void reset( ) noexcept
+		{ release( ); }
+
+		/* Returns 32-bit offset, 0 if null */
+		const std::uint32_t getOffset( ) const noexcept
+		{ return( mOffset ); }
+
+		/* Returns 'reference'. (!) Don't call on null-value. */
+		T & getRef( ) const noexcept
+		{ return( getBlock( )->mObject ); }
+
+		/* Returns 'raw-pointer' */
+		T *const getPtr( ) const noexcept
+		{ return( mOffset != 0 ? &getBlock( )->mObject : nullptr ); }
+
+		/* Returns 'raw-pointer' to the object instance, can be null. Same as #getPtr. */
+		T *const operator*( ) const noexcept
+		{ return( getPtr( ) ); }
+
+		/* Returns number of pointer-'instances'. (!) Don't call on null-value. */
+		const compressed_counter_t & count( ) const noexcept
+		{ return( getBlock( )->mCounter ); }
+
+		/* Returns true if 'pointer' is nullptr */
+		const bool operator==( std::nullptr_t ) const noexcept
+		{ return( mOffset == 0 ); }
+
+		/* Returns true if 'pointer' is not nullptr */
+		const bool operator!=( std::nullptr_t ) const noexcept
+		{ return( mOffset != 0 ); }
+
+		/* Pointer address access operator */
+		T *const operator->( ) const noexcept
+		{ return( getPtr( ) ); }
+
+		/* Returns true if this instance stores same object as given one. */
+		const bool operator==( const compressed_ptr<T> & pOther ) const noexcept
+		{ return( mOffset == pOther.mOffset ); }
+
+		/* Returns true if given object instance is the same as the stored one. */
+		const bool operator==( T *const pObject ) const noexcept
+		{ return( getPtr( ) == pObject ); }
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	/* compressed_ptr stores only offset, can be moved with memcpy */
+	template <typename T>
+	struct is_trivially_relocatable<compressed_ptr<T>> : public std::true_type
+	{
+	};
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_COMPRESSED_PTR_HXX_
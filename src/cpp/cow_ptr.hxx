@@ -0,0 +1,208 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_COW_PTR_HXX_
+#define _C0DE4UN_COW_PTR_HXX_
+
+// Include std::nullptr_t
+#include <cstddef>
+
+// Include std::forward
+#include <utility>
+
+// Include fast_ptr
+#include "fast_ptr.hxx"
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_COW_PTR_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * cow_traits - copy of the shared object, before modification.
+	 *
+	 * (?) Uses copy constructor by default, specialize for other cases
+	 * (polymorphic clone, etc).
+	*/
+	template <typename T>
+	struct cow_traits
+	{
+
+		/*
+		 * Returns copy of the object.
+		 *
+		 * @throws - std::bad_alloc, or copy constructor exception.
+		*/
+		static T *const clone( const T & pObject )
+		{ return( new T( pObject ) ); }
+
+	};
+
+	/*
+	 * cow_ptr - copy-on-write pointer, over fast_ptr shared counter.
+	 *
+	 * Copies share object & read it without copy. Mutable access (#getMutable)
+	 * copies object first, if it's shared with other instances.
+	 *
+	 * (?) With _C0DE4UN_MULTITHREADING_ENABLED_ uniqueness check is an atomic load:
+	 * count 1 means there are no other owners, so no one can share object again.
+	 * (!) Same instance is not thread-safe, same as fast_ptr.
+	 *
+	 * @version 0.1.0
+	*/
+	template <typename T>
+	class cow_ptr final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Shared object */
+		fast_ptr<T> mPointer;
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructor
+		// ===========================================================
+
+		/*
+		 * cow_ptr constructor
+		 *
+		 * @param pObject - object instance to store.
+		*/
+		explicit cow_ptr( T *const pObject = nullptr ) noexcept
+			: mPointer( pObject )
+		{
+		}
+
+		/*
+		 * cow_ptr constructor, shares object of the fast_ptr.
+		 *
+		 * (!) Object must not be modified through other fast_ptr instances.
+		 *
+		 * @param pPointer - fast_ptr.
+		*/
+		explicit cow_ptr( const fast_ptr<T> & pPointer ) noexcept
+			: mPointer( pPointer )
+		{
+		}
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/* Returns true if object is not shared with other instances, or null */
+		const bool isUnique( ) const noexcept
+		{ return( mPointer == nullptr || mPointer.count( ) < 2 ); }
+
+		/* Returns 'raw-pointer' to the shared object, for reading */
+		const T *const get( ) const noexcept
+		{ return( mPointer.getPtr( ) ); }
+
+		/* Returns 'reference' to the shared object, for reading. (!) Don't call on null-value. */
+		const T & getRef( ) const noexcept
+		{ return( mPointer.getRef( ) ); }
+
+		/* Returns shared fast_ptr. (!) Don't modify object through it. */
+		const fast_ptr<T> & getShared( ) const noexcept
+		{ return( mPointer ); }
+
+		/*
+		 * Returns 'raw-pointer' to the object for modification. Copies object first,
+		 * if it's shared.
+		 *
+		 * (?) Returned pointer is valid until this instance is copied, or changed.
+		 *
+		 * @return - object, or null.
+		 * @throws - std::bad_alloc, or copy exception.
+		*/
+		T *const getMutable( )
+		{
+
+			// Copy shared object
+			if ( !isUnique( ) )
+				mPointer = fast_ptr<T>( cow_traits<T>::clone( mPointer.getRef( ) ) );
+
+			// Return result
+			return( mPointer.getPtr( ) );
+
+		}
+
+		// ===========================================================
+		// Methods & Operators
+		// ===========================================================
+
+		/*
+		 * Constructs object.
+		 *
+		 * @param pArgs - object constructor arguments.
+		 * @return - cow_ptr.
+		 * @throws - std::bad_alloc, or object constructor exception.
+		*/
+		template <typename... Args>
+		static cow_ptr<T> make( Args&&... pArgs )
+		{ return( cow_ptr<T>( new T( std::forward<Args>( pArgs )... ) ) ); }
+
+		/* Releases stored object, 'pointer' becomes null */
+		void reset( ) noexcept
+		{ mPointer.reset( ); }
+
+		/* Returns 'raw-pointer' to the object instance, for reading, can be null. Same as #get. */
+		const T *const operator*( ) const noexcept
+		{ return( mPointer.getPtr( ) ); }
+
+		/* Pointer address access operator, for reading */
+		const T *const operator->( ) const noexcept
+		{ return( mPointer.getPtr( ) ); }
+
+		/* Returns true if 'pointer' is nullptr */
+		const bool operator==( std::nullptr_t ) const noexcept
+		{ return( mPointer == nullptr ); }
+
+		/* Returns true if 'pointer' is not nullptr */
+		const bool operator!=( std::nullptr_t ) const noexcept
+		{ return( mPointer != nullptr ); }
+
+		/* Returns true if this instance shares same object as given one. */
+		const bool operator==( const cow_ptr<T> & pOther ) const noexcept
+		{ return( mPointer == pOther.mPointer ); }
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	/* cow_ptr stores only fast_ptr, can be moved with memcpy */
+	template <typename T>
+	struct is_trivially_relocatable<cow_ptr<T>> : public std::true_type
+	{
+	};
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_COW_PTR_HXX_
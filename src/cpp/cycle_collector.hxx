@@ -0,0 +1,1020 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_CYCLE_COLLECTOR_HXX_
+#define _C0DE4UN_CYCLE_COLLECTOR_HXX_
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::chrono
+#include <chrono>
+
+// Include std::map
+#include <map>
+
+// Include std::vector
+#include <vector>
+
+// Include fast_ptr
+#include "fast_ptr.hxx"
+
+// Include rel_ptr
+#include "rel_ptr.hpp"
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_CYCLE_COLLECTOR_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Forward-Declarations
+	// ===========================================================
+
+	class cycle_collector;
+	class cycle_tracer;
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * cycle_traits - edges tracing hook, used by cycle_collector.
+	 *
+	 * (?) By default calls object method "void trace( cycle_tracer & )", which
+	 * must pass every stored fast_ptr & rel_ptr to cycle_tracer#visit. Specialize
+	 * for types, which can't have it.
+	*/
+	template <typename T>
+	struct cycle_traits
+	{
+
+		/* Visits object edges (fast_ptr & rel_ptr fields) */
+		static void trace( T & pObject, cycle_tracer & pTracer )
+		{ pObject.trace( pTracer ); }
+
+	};
+
+	/*
+	 * cycle_tracer - edges visitor, passed to cycle_traits#trace.
+	*/
+	class cycle_tracer final
+	{
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Friends
+		// ===========================================================
+
+		friend class cycle_collector;
+
+		// -------------------------------------------------------- \\
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Collector */
+		cycle_collector & mCollector;
+
+		// ===========================================================
+		// Constructor
+		// ===========================================================
+
+		/* cycle_tracer constructor */
+		explicit cycle_tracer( cycle_collector & pCollector ) noexcept
+			: mCollector( pCollector )
+		{
+		}
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Visits edge of any supported pointer type */
+		template <typename P>
+		void visitEdge( P & pEdge );
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Visits edge. (!) Only fast_ptr, stored in the traced object, can be passed. */
+		template <typename T>
+		void visit( fast_ptr<T> & pEdge )
+		{ visitEdge( pEdge ); }
+
+		/* Visits edge. (!) Only rel_ptr, stored in the traced object, can be passed. */
+		template <typename T>
+		void visit( rel_ptr<T> & pEdge )
+		{ visitEdge( pEdge ); }
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	/*
+	 * cycle_collector - opt-in collector of fast_ptr & rel_ptr reference cycles.
+	 *
+	 * Uses trial deletion: counters of objects, reachable from suspected roots,
+	 * are decreased by internal references (on a side table, real counters are not
+	 * changed). Objects, which counter become zero, are referenced only from the
+	 * garbage cycle: collector breaks their edges & releases them.
+	 *
+	 * Work is done in steps (#collectStep). Root is processed in stages (mark,
+	 * scan, break, release), each stage stores it's worklist & continues in the
+	 * next step, when time budget is over.
+	 *
+	 * (?) Graph can be changed between steps: collector holds reference to each
+	 * found object, & garbage candidates are verified again (counters against
+	 * internal references) in single step, before edges are broken. Changed
+	 * root is suspected again.
+	 * (?) Objects of the rel_ptr registry can be used as roots, see #suspectRegistry.
+	 * (!) Graph must not be changed while step is running: call steps from the
+	 * thread, which owns graph, or while other threads are paused.
+	 *
+	 * @version 0.1.0
+	*/
+	class cycle_collector final
+	{
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Friends
+		// ===========================================================
+
+		friend class cycle_tracer;
+
+		// -------------------------------------------------------- \\
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Types
+		// ===========================================================
+
+		/* Type-specific operations */
+		struct cycle_type;
+
+		/* Edge operations, specialized for fast_ptr & rel_ptr */
+		template <typename P>
+		struct cycle_edge;
+
+		/* fast_ptr edge operations */
+		template <typename T>
+		struct cycle_edge<fast_ptr<T>> final
+		{
+
+			/* Type-Alias for object */
+			using object_t = T;
+
+			/* Returns object address */
+			static const void *const object( fast_ptr<T> & pEdge ) noexcept
+			{ return( pEdge.getPtr( ) ); }
+
+			/* Returns object counter */
+			static const unsigned long count( fast_ptr<T> & pEdge ) noexcept
+			{ return( static_cast<unsigned long>( pEdge.count( ) ) ); }
+
+			/* Resets edge */
+			static void reset( fast_ptr<T> & pEdge ) noexcept
+			{ pEdge.reset( ); }
+
+		};
+
+		/* rel_ptr edge operations */
+		template <typename T>
+		struct cycle_edge<rel_ptr<T>> final
+		{
+
+			/* Type-Alias for object */
+			using object_t = T;
+
+			/* Returns object address */
+			static const void *const object( rel_ptr<T> & pEdge ) noexcept
+			{ return( pEdge.get( ) ); }
+
+			/* Returns object counter */
+			static const unsigned long count( rel_ptr<T> & pEdge ) noexcept
+			{ return( static_cast<unsigned long>( pEdge.count( ) ) ); }
+
+			/* Resets edge, thread-lock of the rel_ptr registry used */
+			static void reset( rel_ptr<T> & pEdge )
+			{ pEdge = rel_ptr<T>( nullptr ); }
+
+		};
+
+		/* Strong reference, type-erased */
+		struct cycle_holder
+		{
+
+			/* cycle_holder destructor, releases reference */
+			virtual ~cycle_holder( ) noexcept
+			{
+			}
+
+			/* Returns stored pointer */
+			virtual void *const getEdge( ) noexcept = 0;
+
+			/* Returns object counter */
+			virtual const unsigned long count( ) noexcept = 0;
+
+			/* Returns type-specific operations */
+			virtual const cycle_type *const getType( ) const noexcept = 0;
+
+		};
+
+		/* Strong reference */
+		template <typename P>
+		struct cycle_pointer final : public cycle_holder
+		{
+
+			/* Reference */
+			P mPointer;
+
+			/* cycle_pointer constructor */
+			explicit cycle_pointer( P & pPointer )
+				: mPointer( pPointer )
+			{
+			}
+
+			/* Returns stored pointer */
+			virtual void *const getEdge( ) noexcept final
+			{ return( &mPointer ); }
+
+			/* Returns object counter */
+			virtual const unsigned long count( ) noexcept final
+			{ return( cycle_edge<P>::count( mPointer ) ); }
+
+			/* Returns type-specific operations */
+			virtual const cycle_type *const getType( ) const noexcept final
+			{ return( &cycle_type_ops<P>::TYPE ); }
+
+		};
+
+		/* Type-specific operations */
+		struct cycle_type
+		{
+
+			/* Traces object edges */
+			void ( *mTrace )( void *const pObject, cycle_tracer & pTracer );
+
+			/* Creates strong reference from edge */
+			cycle_holder *const ( *mRetain )( void *const pEdge );
+
+			/* Resets edge */
+			void ( *mReset )( void *const pEdge );
+
+		};
+
+		/* Type-specific operations */
+		template <typename P>
+		struct cycle_type_ops final
+		{
+
+			/* Traces object edges */
+			static void trace( void *const pObject, cycle_tracer & pTracer )
+			{ cycle_traits<typename cycle_edge<P>::object_t>::trace( *static_cast<typename cycle_edge<P>::object_t*>( pObject ), pTracer ); }
+
+			/* Creates strong reference from edge */
+			static cycle_holder *const retain( void *const pEdge )
+			{ return( new cycle_pointer<P>( *static_cast<P*>( pEdge ) ) ); }
+
+			/* Resets edge */
+			static void reset( void *const pEdge )
+			{ cycle_edge<P>::reset( *static_cast<P*>( pEdge ) ); }
+
+			/* Operations table */
+			static const cycle_type TYPE;
+
+		};
+
+		/* Node color */
+		enum class cycle_color : unsigned char
+		{
+			BLACK, // In use
+			GRAY, // Trial-deleted
+			WHITE // Garbage
+		};
+
+		/* Node state, during trial deletion */
+		struct cycle_node
+		{
+
+			/* Counter, decreased by internal references */
+			long long mCounter;
+
+			/* Color */
+			cycle_color mColor;
+
+			/* Reference, held by collector, until root is processed */
+			cycle_holder * mHolder;
+
+		};
+
+		/* Tracing phase */
+		enum class cycle_phase : unsigned char
+		{
+			MARK_GRAY,
+			SCAN,
+			SCAN_BLACK,
+			VERIFY,
+			BREAK
+		};
+
+		/* Stage of the current root */
+		enum class cycle_stage : unsigned char
+		{
+			IDLE, // No root
+			MARK_GRAY, // Removing internal references
+			SCAN, // Searching garbage
+			VERIFY, // Checking garbage after graph changes, not divided
+			BREAK, // Breaking edges between garbage objects
+			RELEASE // Releasing references, held by collector
+		};
+
+		/* Type-Alias for time point */
+		using time_point_t = std::chrono::steady_clock::time_point;
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Suspected roots, collector holds one reference to each */
+		std::map<const void*, cycle_holder*> mRoots;
+
+		/* Nodes of the current root */
+		std::map<const void*, cycle_node> mNodes;
+
+		/* Objects to trace */
+		std::vector<const void*> mStack;
+
+		/* Objects to mark as used, see cycle_stage::SCAN */
+		std::vector<const void*> mBlackStack;
+
+		/* Current root */
+		const void * mRoot;
+
+		/* Current stage */
+		cycle_stage mStage;
+
+		/* Current tracing phase */
+		cycle_phase mPhase;
+
+		/* Released objects counter */
+		std::size_t mCollected;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Returns true, if step time is over */
+		static const bool isExpired( const time_point_t & pDeadline ) noexcept
+		{ return( std::chrono::steady_clock::now( ) >= pDeadline ); }
+
+		/* Returns number of references, held by collector (node & suspected root) */
+		const long long getHeld( const void *const pObject ) const
+		{ return( 1 + ( mRoots.count( pObject ) > 0 ? 1 : 0 ) ); }
+
+		/* Returns node, or null, if object is not found from the current root */
+		cycle_node *const findNode( const void *const pObject )
+		{
+
+			std::map<const void*, cycle_node>::iterator nodePos = mNodes.find( pObject );
+			return( nodePos != mNodes.end( ) ? &nodePos->second : nullptr );
+
+		}
+
+		/*
+		 * Returns node, creates it & holds the object on first access.
+		 *
+		 * @throws - std::bad_alloc.
+		*/
+		cycle_node & getNode( const void *const pObject, void *const pEdge, const cycle_type *const pType )
+		{
+
+			// Search
+			std::map<const void*, cycle_node>::iterator nodePos = mNodes.find( pObject );
+			if ( nodePos != mNodes.end( ) )
+				return( nodePos->second );
+
+			// Hold
+			cycle_holder *const holder_lp( pType->mRetain( pEdge ) );
+
+			// Create
+			cycle_node * node_lp( nullptr );
+			try
+			{
+				node_lp = &mNodes[pObject];
+			}
+			catch ( ... )
+			{
+				delete holder_lp;
+				throw;
+			}
+			node_lp->mCounter = static_cast<long long>( holder_lp->count( ) ) - getHeld( pObject );
+			node_lp->mColor = cycle_color::BLACK;
+			node_lp->mHolder = holder_lp;
+
+			// Return result
+			return( *node_lp );
+
+		}
+
+		/* Called by cycle_tracer for each edge */
+		void onEdge( void *const pEdge, const void *const pObject, const cycle_type *const pType )
+		{
+
+			// Only objects, found while marking, are processed
+			cycle_node *const node_lp( mPhase == cycle_phase::MARK_GRAY ? &getNode( pObject, pEdge, pType ) : findNode( pObject ) );
+			if ( node_lp == nullptr )
+				return;
+
+			switch ( mPhase )
+			{
+
+			case cycle_phase::MARK_GRAY:
+				// Remove internal reference
+				node_lp->mCounter--;
+				mStack.push_back( pObject );
+				break;
+
+			case cycle_phase::SCAN:
+				mStack.push_back( pObject );
+				break;
+
+			case cycle_phase::SCAN_BLACK:
+				// Restore internal reference
+				node_lp->mCounter++;
+				if ( node_lp->mColor != cycle_color::BLACK )
+					mBlackStack.push_back( pObject );
+				break;
+
+			case cycle_phase::VERIFY:
+				// Remove reference between garbage objects
+				if ( node_lp->mColor == cycle_color::WHITE )
+					node_lp->mCounter--;
+				break;
+
+			case cycle_phase::BREAK:
+				// Edge between garbage objects
+				if ( node_lp->mColor == cycle_color::WHITE )
+					pType->mReset( pEdge );
+				break;
+
+			}
+
+		}
+
+		/* Traces object edges in the given phase */
+		void trace( const void *const pObject, cycle_node & pNode, const cycle_phase pPhase )
+		{
+
+			// Phase
+			mPhase = pPhase;
+
+			// Trace
+			cycle_tracer tracer_( *this );
+			pNode.mHolder->getType( )->mTrace( const_cast<void*>( pObject ), tracer_ );
+
+		}
+
+		/*
+		 * Starts trial deletion from the first suspected root. Collector reference
+		 * is moved to the root node.
+		 *
+		 * @throws - std::bad_alloc.
+		*/
+		void startRoot( )
+		{
+
+			// Root
+			std::map<const void*, cycle_holder*>::iterator rootPos = mRoots.begin( );
+			cycle_node & node_lr( mNodes[rootPos->first] );
+			node_lr.mHolder = rootPos->second;
+			node_lr.mCounter = static_cast<long long>( node_lr.mHolder->count( ) ) - 1;
+			node_lr.mColor = cycle_color::BLACK;
+			mRoot = rootPos->first;
+			mRoots.erase( rootPos );
+
+			// Mark gray, from root
+			mStack.push_back( mRoot );
+			mStage = cycle_stage::MARK_GRAY;
+
+		}
+
+		/* Marks objects gray, removing internal references. Returns false, if time is over. */
+		const bool markGray( const time_point_t & pDeadline )
+		{
+
+			while ( !mStack.empty( ) )
+			{
+
+				// Next
+				const void *const object_lp( mStack.back( ) );
+				mStack.pop_back( );
+				cycle_node & node_lr( mNodes[object_lp] );
+
+				// Already gray
+				if ( node_lr.mColor == cycle_color::GRAY )
+					continue;
+
+				// Mark & remove internal references
+				node_lr.mColor = cycle_color::GRAY;
+				trace( object_lp, node_lr, cycle_phase::MARK_GRAY );
+
+				// Time is over
+				if ( isExpired( pDeadline ) )
+					return( false );
+
+			}
+
+			// Scan, from root
+			mStack.push_back( mRoot );
+			mStage = cycle_stage::SCAN;
+
+			// Return OK
+			return( true );
+
+		}
+
+		/*
+		 * Marks gray objects as garbage (white), or as used (black), if external
+		 * references found, restoring counters. Returns false, if time is over.
+		*/
+		const bool scan( const time_point_t & pDeadline )
+		{
+
+			while ( !mBlackStack.empty( ) || !mStack.empty( ) )
+			{
+
+				// Mark used first
+				if ( !mBlackStack.empty( ) )
+				{
+
+					// Next
+					const void *const object_lp( mBlackStack.back( ) );
+					mBlackStack.pop_back( );
+					cycle_node & node_lr( mNodes[object_lp] );
+
+					// Already black
+					if ( node_lr.mColor == cycle_color::BLACK )
+						continue;
+
+					// Mark
+					node_lr.mColor = cycle_color::BLACK;
+					trace( object_lp, node_lr, cycle_phase::SCAN_BLACK );
+
+				}
+				else
+				{
+
+					// Next
+					const void *const object_lp( mStack.back( ) );
+					mStack.pop_back( );
+					cycle_node & node_lr( mNodes[object_lp] );
+
+					// Already scanned
+					if ( node_lr.mColor != cycle_color::GRAY )
+						continue;
+
+					// External references found
+					if ( node_lr.mCounter > 0 )
+					{
+						mBlackStack.push_back( object_lp );
+						continue;
+					}
+
+					// Garbage candidate
+					node_lr.mColor = cycle_color::WHITE;
+					trace( object_lp, node_lr, cycle_phase::SCAN );
+
+				}
+
+				// Time is over
+				if ( isExpired( pDeadline ) )
+					return( false );
+
+			}
+
+			// Verify
+			mStage = cycle_stage::VERIFY;
+
+			// Return OK
+			return( true );
+
+		}
+
+		/*
+		 * Checks, that garbage candidates are referenced only by each other & by
+		 * collector, with current counters & edges. Not divided: graph can be
+		 * changed between steps only.
+		 *
+		 * (?) If graph is changed, nothing is released & root is suspected again.
+		*/
+		void verify( )
+		{
+
+			// Counters, without collector references
+			bool garbage_( false );
+			for ( std::pair<const void *const, cycle_node> & node_lr : mNodes )
+			{
+				if ( node_lr.second.mColor == cycle_color::WHITE )
+				{
+					node_lr.second.mCounter = static_cast<long long>( node_lr.second.mHolder->count( ) ) - getHeld( node_lr.first );
+					garbage_ = true;
+				}
+			}
+
+			// Remove references between garbage objects
+			for ( std::pair<const void *const, cycle_node> & node_lr : mNodes )
+			{
+				if ( node_lr.second.mColor == cycle_color::WHITE )
+					trace( node_lr.first, node_lr.second, cycle_phase::VERIFY );
+			}
+
+			// External references
+			bool changed_( false );
+			for ( std::pair<const void *const, cycle_node> & node_lr : mNodes )
+			{
+				if ( node_lr.second.mColor == cycle_color::WHITE && node_lr.second.mCounter != 0 )
+					changed_ = true;
+			}
+
+			// Graph changed, keep all objects & process root again
+			if ( changed_ )
+			{
+
+				for ( std::pair<const void *const, cycle_node> & node_lr : mNodes )
+					node_lr.second.mColor = cycle_color::BLACK;
+
+				if ( mRoots.count( mRoot ) < 1 )
+				{
+					cycle_holder *const root_lp( mNodes[mRoot].mHolder );
+					mRoots[mRoot] = root_lp->getType( )->mRetain( root_lp->getEdge( ) );
+				}
+
+				garbage_ = false;
+
+			}
+
+			// Nothing to break
+			if ( !garbage_ )
+			{
+				mStage = cycle_stage::RELEASE;
+				return;
+			}
+
+			// Forget garbage roots & break edges of each garbage object
+			for ( std::pair<const void *const, cycle_node> & node_lr : mNodes )
+			{
+
+				// Used
+				if ( node_lr.second.mColor != cycle_color::WHITE )
+					continue;
+
+				// Release collector reference, node holds object
+				std::map<const void*, cycle_holder*>::iterator rootPos = mRoots.find( node_lr.first );
+				if ( rootPos != mRoots.end( ) )
+				{
+					delete rootPos->second;
+					mRoots.erase( rootPos );
+				}
+
+				// Break
+				mStack.push_back( node_lr.first );
+
+			}
+
+			mStage = cycle_stage::BREAK;
+
+		}
+
+		/*
+		 * Breaks edges between garbage objects. Returns false, if time is over.
+		 *
+		 * (?) Divided: verified garbage is not reachable by the graph owner.
+		*/
+		const bool breakEdges( const time_point_t & pDeadline )
+		{
+
+			while ( !mStack.empty( ) )
+			{
+
+				// Next
+				const void *const object_lp( mStack.back( ) );
+				mStack.pop_back( );
+				trace( object_lp, mNodes[object_lp], cycle_phase::BREAK );
+
+				// Time is over
+				if ( isExpired( pDeadline ) )
+					return( false );
+
+			}
+
+			// Release
+			mStage = cycle_stage::RELEASE;
+
+			// Return OK
+			return( true );
+
+		}
+
+		/* Releases references, held by collector. Garbage is deleted. Returns false, if time is over. */
+		const bool release( const time_point_t & pDeadline )
+		{
+
+			while ( !mNodes.empty( ) )
+			{
+
+				// Next
+				std::map<const void*, cycle_node>::iterator nodePos = mNodes.begin( );
+				cycle_holder *const holder_lp( nodePos->second.mHolder );
+				if ( nodePos->second.mColor == cycle_color::WHITE )
+					mCollected++;
+				mNodes.erase( nodePos );
+
+				// Release, can delete object
+				delete holder_lp;
+
+				// Time is over
+				if ( isExpired( pDeadline ) )
+					return( false );
+
+			}
+
+			// Done
+			mRoot = nullptr;
+			mStage = cycle_stage::IDLE;
+
+			// Return OK
+			return( true );
+
+		}
+
+		/*
+		 * Continues current root, or starts next one.
+		 *
+		 * @param pDeadline - end of step.
+		 * @return - false, if time is over, or there are no roots.
+		 * @throws - std::bad_alloc.
+		*/
+		const bool process( const time_point_t & pDeadline )
+		{
+
+			switch ( mStage )
+			{
+
+			case cycle_stage::IDLE:
+				if ( mRoots.empty( ) )
+					return( false );
+				startRoot( );
+				return( true );
+
+			case cycle_stage::MARK_GRAY:
+				return( markGray( pDeadline ) );
+
+			case cycle_stage::SCAN:
+				return( scan( pDeadline ) );
+
+			case cycle_stage::VERIFY:
+				verify( );
+				return( !isExpired( pDeadline ) );
+
+			case cycle_stage::BREAK:
+				return( breakEdges( pDeadline ) );
+
+			case cycle_stage::RELEASE:
+				return( release( pDeadline ) );
+
+			}
+
+			// Return
+			return( false );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructor & destructor
+		// ===========================================================
+
+		/* cycle_collector constructor */
+		cycle_collector( ) noexcept
+			: mRoots( ),
+			mNodes( ),
+			mStack( ),
+			mBlackStack( ),
+			mRoot( nullptr ),
+			mStage( cycle_stage::IDLE ),
+			mPhase( cycle_phase::MARK_GRAY ),
+			mCollected( 0 )
+		{
+		}
+
+		/*
+		 * cycle_collector destructor, releases suspected roots & found objects
+		 * without collecting.
+		*/
+		~cycle_collector( ) noexcept
+		{
+
+			// Release
+			for ( std::pair<const void *const, cycle_holder*> & root_lr : mRoots )
+				delete root_lr.second;
+			for ( std::pair<const void *const, cycle_node> & node_lr : mNodes )
+				delete node_lr.second.mHolder;
+
+		}
+
+		// ===========================================================
+		// Deleted
+		// ===========================================================
+
+		/* @deleted cycle_collector const copy constructor */
+		cycle_collector( const cycle_collector & ) = delete;
+
+		/* @deleted cycle_collector const copy assignment operator */
+		cycle_collector & operator=( const cycle_collector & ) = delete;
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/* Returns number of suspected roots, waiting for collection, including current one */
+		const std::size_t pending( ) const noexcept
+		{ return( mRoots.size( ) + ( mStage != cycle_stage::IDLE ? 1 : 0 ) ); }
+
+		/* Returns number of objects, released by collector */
+		const std::size_t collected( ) const noexcept
+		{ return( mCollected ); }
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Adds object, which can be part of the garbage cycle (for example, after
+		 * dropping a reference to it). Collector holds a reference until it's checked.
+		 *
+		 * @param pPointer - suspected root, null ignored.
+		 * @throws - std::bad_alloc.
+		*/
+		template <typename T>
+		void suspect( const fast_ptr<T> & pPointer )
+		{
+
+			// Cancel
+			if ( pPointer == nullptr || mRoots.count( pPointer.getPtr( ) ) > 0 )
+				return;
+
+			// Hold
+			fast_ptr<T> pointer_( pPointer );
+			mRoots[pPointer.getPtr( )] = new cycle_pointer<fast_ptr<T>>( pointer_ );
+
+		}
+
+		/*
+		 * Adds object, which can be part of the garbage cycle, see #suspect.
+		 *
+		 * @param pPointer - suspected root, null ignored.
+		 * @throws - std::bad_alloc, mutex.
+		*/
+		template <typename T>
+		void suspect( rel_ptr<T> & pPointer )
+		{
+
+			// Cancel
+			if ( pPointer == nullptr || mRoots.count( pPointer.get( ) ) > 0 )
+				return;
+
+			// Hold
+			mRoots[pPointer.get( )] = new cycle_pointer<rel_ptr<T>>( pPointer );
+
+		}
+
+		/*
+		 * Suspects all objects of the rel_ptr registry, which have instances,
+		 * see rel_ptr#instances.
+		 *
+		 * @throws - std::bad_alloc, mutex.
+		*/
+		template <typename T>
+		void suspectRegistry( )
+		{
+
+			// Instances
+			std::vector<rel_ptr<T>> instances_( rel_ptr<T>::instances( ) );
+
+			// Suspect
+			for ( rel_ptr<T> & instance_lr : instances_ )
+				suspect( instance_lr );
+
+		}
+
+		/*
+		 * Processes suspected roots, until time budget is over.
+		 *
+		 * (?) At least one object is processed. Root work is divided between
+		 * steps, except verification of the garbage candidates.
+		 *
+		 * @param pBudget - time budget.
+		 * @return - true if there are roots left.
+		 * @throws - std::bad_alloc, mutex (rel_ptr).
+		*/
+		const bool collectStep( const std::chrono::microseconds pBudget )
+		{
+
+			// Deadline
+			const time_point_t deadline_( std::chrono::steady_clock::now( ) + pBudget );
+
+			// Process roots
+			while ( process( deadline_ ) && !isExpired( deadline_ ) )
+			{
+			}
+
+			// Return result
+			return( pending( ) > 0 );
+
+		}
+
+		/*
+		 * Processes all suspected roots.
+		 *
+		 * @throws - std::bad_alloc, mutex (rel_ptr).
+		*/
+		void collect( )
+		{
+
+			// Process roots
+			while ( process( time_point_t::max( ) ) )
+			{
+			}
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	// ===========================================================
+	// Methods
+	// ===========================================================
+
+	/* Visits edge */
+	template <typename P>
+	inline void cycle_tracer::visitEdge( P & pEdge )
+	{
+
+		// Null
+		const void *const object_lp( cycle_collector::cycle_edge<P>::object( pEdge ) );
+		if ( object_lp == nullptr )
+			return;
+
+		// Notify collector
+		mCollector.onEdge( &pEdge, object_lp, &cycle_collector::cycle_type_ops<P>::TYPE );
+
+	}
+
+	// ===========================================================
+	// Fields
+	// ===========================================================
+
+	/* Operations table */
+	template <typename P>
+	const cycle_collector::cycle_type cycle_collector::cycle_type_ops<P>::TYPE = { &cycle_type_ops<P>::trace, &cycle_type_ops<P>::retain, &cycle_type_ops<P>::reset };
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_CYCLE_COLLECTOR_HXX_
@@ -16,6 +16,24 @@
 #include <atomic>
 #endif // !_C0DE4UN_MULTITHREADING_ENABLED_
 
+// Include std::abort
+#include <cstdlib>
+
+// Include std::fputs
+#include <cstdio>
+
+// Include is_trivially_relocatable
+#include "relocatable.hxx"
+
+// Include _C0DE4UN_POINTERS_TRACE_
+#include "ptr_trace.hxx"
+
+// Include _C0DE4UN_POINTERS_BORROW_CHECK_
+#include "borrow_tracker.hxx"
+
+// Include release_queue
+#include "release_queue.hxx"
+
 // Mark as Declared, in cases of Forward Declaration
 #define _C0DE4UN_FAST_PTR_DECL_
 
@@ -24,6 +42,18 @@ namespace c0de4un
 
 	// -------------------------------------------------------- \\
 
+	// ===========================================================
+	// Constants
+	// ===========================================================
+
+	/*
+	 * Counter value of the immortal fast_ptr control block: copies & releases
+	 * don't change the counter, object is never deleted. Max number of the
+	 * instances of the mortal object is FAST_PTR_IMMORTAL - 1, next copy aborts
+	 * program (see fast_ptr_block::retain).
+	*/
+	constexpr unsigned short FAST_PTR_IMMORTAL = 0xFFFF;
+
 	// ===========================================================
 	// Types
 	// ===========================================================
@@ -46,8 +76,96 @@ namespace c0de4un
 
 #endif // _C0DE4UN_MULTITHREADING_ENABLED_
 
+	/*
+	 * fast_ptr_block - shared between pointers instances control block.
+	 *
+	 * (?) Custom #mRelease frees object & block, when last instance released,
+	 * for objects & blocks, not allocated by new (see allocate_fast).
+	*/
+	struct fast_ptr_block
+	{
+
+		/* Type-Alias for release function: ( block, object ) */
+		using release_t = void ( * )( fast_ptr_block *const, void *const );
+
+		/* Instances counter */
+		counter_t mCounter;
+
+		/* Release function, null to delete object & block */
+		release_t mRelease;
+
+		/*
+		 * fast_ptr_block constructor, single instance.
+		 *
+		 * @param pRelease - release function, null to delete object & block.
+		*/
+		explicit fast_ptr_block( const release_t pRelease = nullptr ) noexcept
+			: mCounter( 1 ),
+			mRelease( pRelease )
+		{
+		}
+
+		/* Returns true, if counter is FAST_PTR_IMMORTAL. (?) Immortal counter is never changed, so relaxed load is enough. */
+		const bool isImmortal( ) const noexcept
+		{
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+			return( mCounter.load( std::memory_order_relaxed ) == FAST_PTR_IMMORTAL );
+#else
+			return( mCounter == FAST_PTR_IMMORTAL );
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+		}
+
+		/*
+		 * Adds instance of the mortal object.
+		 *
+		 * (!) Program is aborted, if counter would reach FAST_PTR_IMMORTAL:
+		 * object can't become immortal by copies, & counter can't wrap to zero.
+		*/
+		void retain( ) noexcept
+		{
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+			unsigned short count_( mCounter.load( ) );
+			do
+			{
+				if ( count_ >= FAST_PTR_IMMORTAL - 1 )
+					overflow( );
+			}
+			while ( !mCounter.compare_exchange_weak( count_, static_cast<unsigned short>( count_ + 1 ) ) );
+#else
+			if ( mCounter >= FAST_PTR_IMMORTAL - 1 )
+				overflow( );
+			mCounter++;
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+		}
+
+		/* Aborts program, instances counter overflow */
+		[[noreturn]] static void overflow( ) noexcept
+		{
+			std::fputs( "fast_ptr: instances counter overflow\n", stderr );
+			std::abort( );
+		}
+
+	};
+
 	// -------------------------------------------------------- \\
 
+	// ===========================================================
+	// Forward-Declarations
+	// ===========================================================
+
+	template <typename T>
+	struct fast_ptr_bulk;
+
+	template <typename T>
+	class fast_ptr_queue;
+
+	template <typename T>
+	class unique_fast_ptr;
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
 	/*
 	 * fast_ptr - simple & fast shared pointer.
 	 *
@@ -57,6 +175,23 @@ namespace c0de4un
 	class fast_ptr final
 	{
 
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Friends
+		// ===========================================================
+
+		/* Bulk operations over arrays of pointers */
+		friend struct fast_ptr_bulk<T>;
+
+		/* Moves ownership through the queue slots */
+		friend class fast_ptr_queue<T>;
+
+		/* Promotes single owner in place */
+		friend class unique_fast_ptr<T>;
+
+		// -------------------------------------------------------- \\
+
 	private:
 
 		// -------------------------------------------------------- \\
@@ -68,8 +203,86 @@ namespace c0de4un
 		/* Sharable, between pointers instances, object instance */
 		T * mObject;
 
-		/* Shared between Pointers Instances Counter */
-		counter_t * mCounter;
+		/* Shared between Pointers Instances control block (counter) */
+		fast_ptr_block * mCounter;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Deletes object & control block */
+		static void deleteObject( void *const pObject, fast_ptr_block *const pBlock ) noexcept
+		{
+
+			// Custom release
+			if ( pBlock->mRelease != nullptr )
+			{
+				pBlock->mRelease( pBlock, pObject );
+				return;
+			}
+
+			// Delete Object
+			if ( pObject != nullptr )
+				delete static_cast<T*>( pObject );
+
+			// Delete counter
+			delete pBlock;
+
+		}
+
+		/*
+		 * Deletes object & control block, after last instance released.
+		 *
+		 * (?) With _C0DE4UN_POINTERS_ITERATIVE_RELEASE_ENABLED_ objects, released
+		 * by the object destructor, are deleted after it, without recursion.
+		*/
+		static void destroy( T *const pObject, fast_ptr_block *const pBlock ) noexcept
+		{
+
+			// Object address, for fast_ptr<const T> too
+			void *const object_lp( const_cast<void*>( static_cast<const void*>( pObject ) ) );
+
+#ifdef _C0DE4UN_POINTERS_ITERATIVE_RELEASE_ENABLED_
+			release_queue::release( object_lp, pBlock, &fast_ptr<T>::deleteObject );
+#else
+			deleteObject( object_lp, pBlock );
+#endif // _C0DE4UN_POINTERS_ITERATIVE_RELEASE_ENABLED_
+
+		}
+
+		/* Decreases counter & deletes object, if last instance. Resets this instance. */
+		void release( ) noexcept
+		{
+
+			// Decrease counter, if object is not immortal
+			if ( mCounter != nullptr && !mCounter->isImmortal( ) )
+			{
+
+				// Get reference to the counter
+				counter_t & counter_lr = mCounter->mCounter;
+
+				// Trace
+				_C0DE4UN_POINTERS_TRACE_( RELEASE, mObject );
+
+				// Decrease Pointers Instances Counter. Single (atomic) operation, so
+				// only one instance can see zero.
+				if ( --counter_lr < 1 )
+				{
+					// Trace
+					_C0DE4UN_POINTERS_TRACE_( FREE, mObject );
+					_C0DE4UN_POINTERS_BORROW_CHECK_( mObject );
+
+					// Delete Object & counter
+					destroy( mObject, mCounter );
+				}
+
+			}
+
+			// Reset
+			mObject = nullptr;
+			mCounter = nullptr;
+
+		}
 
 		// -------------------------------------------------------- \\
 
@@ -88,8 +301,31 @@ namespace c0de4un
 		*/
 		explicit fast_ptr( T *const pObject = nullptr ) noexcept
 			: mObject( pObject ),
-			mCounter( pObject != nullptr ? new counter_t( 1 ) : nullptr )
+			mCounter( pObject != nullptr ? new fast_ptr_block( ) : nullptr )
 		{
+
+			// Trace
+			_C0DE4UN_POINTERS_TRACE_( CREATE, pObject );
+
+		}
+
+		/*
+		 * fast_ptr constructor with custom control block.
+		 *
+		 * (!) Takes the block's single instance (counter must be 1). Block's
+		 * release function frees object & block, see allocate_fast.
+		 *
+		 * @param pObject - object instance to store.
+		 * @param pBlock - control block.
+		*/
+		fast_ptr( T *const pObject, fast_ptr_block *const pBlock ) noexcept
+			: mObject( pObject ),
+			mCounter( pBlock )
+		{
+
+			// Trace
+			_C0DE4UN_POINTERS_TRACE_( CREATE, pObject );
+
 		}
 
 		/*
@@ -100,8 +336,12 @@ namespace c0de4un
 			mCounter( pOther.mCounter )
 		{
 
-			// Increase Pointers-Instances Counter
-			( *mCounter )++;
+			// Increase Pointers-Instances Counter, if object is not immortal
+			if ( mCounter != nullptr && !mCounter->isImmortal( ) )
+			{
+				_C0DE4UN_POINTERS_TRACE_( COPY, mObject );
+				mCounter->retain( );
+			}
 
 		}
 
@@ -111,17 +351,24 @@ namespace c0de4un
 		fast_ptr<T> & operator=( const fast_ptr<T> & pOther ) noexcept
 		{
 
-			// Cancel if self-copy
-			if ( this == &pOther )
+			// Cancel if self-copy, or same object
+			if ( this == &pOther || mCounter == pOther.mCounter )
 				return( *this );
 
+			// Increase Pointers-Instances Counter of the new object, if it's not immortal
+			if ( pOther.mCounter != nullptr && !pOther.mCounter->isImmortal( ) )
+			{
+				_C0DE4UN_POINTERS_TRACE_( COPY, pOther.mObject );
+				pOther.mCounter->retain( );
+			}
+
+			// Release previous object
+			release( );
+
 			// Copy values
 			mObject = pOther.mObject;
 			mCounter = pOther.mCounter;
 
-			// Increase Pointers-Instances Counter
-			( *mCounter )++;
-
 			// Return
 			return( *this );
 
@@ -151,6 +398,9 @@ namespace c0de4un
 			if ( this == &pOther )
 				return( *this );
 
+			// Release previous object
+			release( );
+
 			// Copy values
 			mObject = pOther.mObject;
 			mCounter = pOther.mCounter;
@@ -166,57 +416,65 @@ namespace c0de4un
 
 		/* fast_ptr Destructor */
 		~fast_ptr( ) noexcept
-		{
-
-			// Decrease counter
-			if ( mCounter != nullptr )
-			{
-
-				// Get reference to the counter
-				counter_t & counter_lr = *mCounter;
-
-				// Decrease Pointers Instances Counter
-				counter_lr--;
-
-				// If last instance
-				if ( counter_lr < 1 )
-				{
-					// Delete Object
-					if ( mObject != nullptr )
-						delete mObject;
-
-					// Delete counter
-					delete mCounter;
-				}
-
-			}
-
-		}
+		{ release( ); }
 
 		// ===========================================================
 		// Methods & Operators
 		// ===========================================================
 
-		/* Assign (set) object to store. */
+		/*
+		 * Assign (set) object to store. Previous object is released, null resets 'pointer'.
+		 *
+		 * (?) Previous control block is never reused for the new object: custom
+		 * block (see fast_ptr_block::mRelease) frees own object & storage.
+		*/
 		void operator=( T *const pObject ) noexcept
 		{
 
 			// Cancel
-			if ( mObject == pObject || pObject == nullptr )
+			if ( mObject == pObject )
 				return;
 
-			// Set pointer-value
+			// Release previous object
+			release( );
+
+			// Cancel
+			if ( pObject == nullptr )
+				return;
+
+			// Set pointer-value & new instances counter
 			mObject = pObject;
+			mCounter = new fast_ptr_block( );
 
-			// Update instances counter
-			if ( *mCounter > 1 )
-			{// Other 'smart-pointers' stores previous object
-				// New instances counter for new Object
-				mCounter = new counter_t( 1 );
-			}
+			// Trace
+			_C0DE4UN_POINTERS_TRACE_( CREATE, pObject );
 
 		}
 
+		/* Releases stored object, 'pointer' becomes null */
+		void reset( ) noexcept
+		{ release( ); }
+
+		/*
+		 * Makes object immortal: copies & releases don't change the counter, so
+		 * instances don't write shared cache-line. Object is never deleted.
+		 *
+		 * (!) Call before object is shared between threads, counter is not
+		 * updated atomically with other instances.
+		 * (?) Does nothing, if 'pointer' is null.
+		*/
+		void makeImmortal( ) noexcept
+		{
+
+			if ( mCounter != nullptr )
+				mCounter->mCounter = FAST_PTR_IMMORTAL;
+
+		}
+
+		/* Returns true, if object is immortal, see #makeImmortal */
+		const bool isImmortal( ) const noexcept
+		{ return( mCounter != nullptr && mCounter->isImmortal( ) ); }
+
 		///* Assignment (set, share) object from other pointer-instance */
 		//void operator=( const fast_ptr<T> pOther ) noexcept
 		//{
@@ -251,11 +509,11 @@ namespace c0de4un
 		//}
 
 		/* Returns 'reference'. (!) Don't call on null-value. */
-		T & getRef( ) noexcept
+		T & getRef( ) const noexcept
 		{ return( *mObject ); }
 
 		/* Returns 'raw-pointer' */
-		T *const getPtr( ) noexcept
+		T *const getPtr( ) const noexcept
 		{ return( mObject ); }
 
 		/* Returns 'raw-pointer' to the object instance, can be null. Same as #getReference. */
@@ -264,7 +522,11 @@ namespace c0de4un
 
 		/* Returns number of pointer-'instances' */
 		const counter_t & count( ) const noexcept
-		{ return( *mCounter ); }
+		{ return( mCounter->mCounter ); }
+
+		/* Returns control block, null if 'pointer' is null. (?) Used to detect custom blocks. */
+		fast_ptr_block *const getBlock( ) const noexcept
+		{ return( mCounter ); }
 
 		/* Returns true if 'pointer' is nullptr */
 		const bool operator==( nullptr_t ) const noexcept
@@ -290,6 +552,14 @@ namespace c0de4un
 
 	};
 
+	// -------------------------------------------------------- \\
+
+	/* fast_ptr stores only addresses of the object & counter, can be moved with memcpy */
+	template <typename T>
+	struct is_trivially_relocatable<fast_ptr<T>> : public std::true_type
+	{
+	};
+
 }
 
 #endif // !_C0DE4UN_FAST_PTR_HXX_
\ No newline at end of file
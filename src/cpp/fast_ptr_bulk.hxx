@@ -0,0 +1,376 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_FAST_PTR_BULK_HXX_
+#define _C0DE4UN_FAST_PTR_BULK_HXX_
+
+// Include std::size_t
+#include <cstddef>
+
+// Include std::sort
+#include <algorithm>
+
+// Include std::vector
+#include <vector>
+
+// Include std::bad_alloc
+#include <new>
+
+// Include std::overflow_error
+#include <stdexcept>
+
+// Include fast_ptr
+#include "fast_ptr.hxx"
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_FAST_PTR_BULK_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * fast_ptr_bulk - operations over arrays of fast_ptr.
+	 *
+	 * Elements are grouped by counter, so each shared object gets one combined
+	 * counter update, instead of one per element. Grouping is a sort of counters
+	 * addresses, used only for arrays larger than #GROUP_THRESHOLD.
+	 *
+	 * @version 0.1.0
+	*/
+	template <typename T>
+	struct fast_ptr_bulk final
+	{
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constants
+		// ===========================================================
+
+		/* Arrays up to this size are updated per element */
+		static constexpr std::size_t GROUP_THRESHOLD = 16;
+
+		// ===========================================================
+		// Types
+		// ===========================================================
+
+		/* Counter & object, taken from element */
+		struct fast_ptr_entry
+		{
+
+			/* Counter */
+			fast_ptr_block * mCounter;
+
+			/* Object */
+			T * mObject;
+
+			/* Sort by counter address */
+			const bool operator<( const fast_ptr_entry & pOther ) const noexcept
+			{ return( mCounter < pOther.mCounter ); }
+
+		};
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Adds references to the counter, if result is less than FAST_PTR_IMMORTAL.
+		 *
+		 * @param pBlock - counter, not immortal.
+		 * @param pReferences - references to add.
+		 * @return - false, if counter would overflow (counter is not changed).
+		*/
+		static const bool add( fast_ptr_block *const pBlock, const std::size_t pReferences ) noexcept
+		{
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+			unsigned short count_( pBlock->mCounter.load( ) );
+			do
+			{
+				if ( pReferences >= static_cast<std::size_t>( FAST_PTR_IMMORTAL - count_ ) )
+					return( false );
+			}
+			while ( !pBlock->mCounter.compare_exchange_weak( count_, static_cast<unsigned short>( count_ + pReferences ) ) );
+#else
+			if ( pReferences >= static_cast<std::size_t>( FAST_PTR_IMMORTAL - pBlock->mCounter ) )
+				return( false );
+			pBlock->mCounter += static_cast<unsigned short>( pReferences );
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+			// Return OK
+			return( true );
+
+		}
+
+		/*
+		 * Adds references to every element's object.
+		 *
+		 * (?) All or nothing: if any counter would reach FAST_PTR_IMMORTAL, added
+		 * references are removed & exception is thrown.
+		 *
+		 * @param pPointers - elements, can be null.
+		 * @param pCount - number of elements.
+		 * @param pReferences - references to add per element.
+		 * @throws - std::bad_alloc, std::overflow_error.
+		*/
+		static void retain( const fast_ptr<T> *const pPointers, const std::size_t pCount, const unsigned int pReferences )
+		{
+
+			// Small array
+			if ( pCount <= GROUP_THRESHOLD )
+			{
+				for ( std::size_t i = 0; i < pCount; i++ )
+				{
+
+					// Null, or immortal
+					if ( pPointers[i].mCounter == nullptr || pPointers[i].mCounter->isImmortal( ) )
+						continue;
+
+					// Overflow, remove added references
+					if ( !add( pPointers[i].mCounter, pReferences ) )
+					{
+						for ( std::size_t j = 0; j < i; j++ )
+						{
+							if ( pPointers[j].mCounter != nullptr && !pPointers[j].mCounter->isImmortal( ) )
+								pPointers[j].mCounter->mCounter -= static_cast<unsigned short>( pReferences );
+						}
+						throw std::overflow_error( "fast_ptr_bulk::retain - counter overflow" );
+					}
+
+				}
+			}
+			else
+			{
+
+				// Group by counter
+				std::vector<fast_ptr_entry> entries_( group( pPointers, pCount ) );
+
+				// One update per counter
+				for ( std::size_t i = 0; i < entries_.size( ); )
+				{
+
+					// Number of elements with the same counter
+					std::size_t last_( i + 1 );
+					while ( last_ < entries_.size( ) && entries_[last_].mCounter == entries_[i].mCounter )
+						last_++;
+
+					// Overflow, remove added references
+					if ( !add( entries_[i].mCounter, ( last_ - i ) * pReferences ) )
+					{
+						for ( std::size_t j = 0; j < i; j++ )
+							entries_[j].mCounter->mCounter -= static_cast<unsigned short>( pReferences );
+						throw std::overflow_error( "fast_ptr_bulk::retain - counter overflow" );
+					}
+
+					i = last_;
+
+				}
+
+			}
+
+#ifdef _C0DE4UN_POINTERS_TRACE_ENABLED_
+			// Trace, reference per operation
+			for ( std::size_t i = 0; i < pCount; i++ )
+			{
+				for ( unsigned int j = 0; j < pReferences; j++ )
+					_C0DE4UN_POINTERS_TRACE_( COPY, pPointers[i].mObject );
+			}
+#endif // _C0DE4UN_POINTERS_TRACE_ENABLED_
+
+		}
+
+		/*
+		 * Releases every element, elements become null.
+		 *
+		 * (?) Falls back to per-element release, if there is no memory for grouping.
+		 *
+		 * @param pPointers - elements, can be null.
+		 * @param pCount - number of elements.
+		*/
+		static void release( fast_ptr<T> *const pPointers, const std::size_t pCount ) noexcept
+		{
+
+			// Group by counter
+			std::vector<fast_ptr_entry> entries_;
+			try
+			{
+				if ( pCount > GROUP_THRESHOLD )
+					entries_ = group( pPointers, pCount );
+			}
+			catch ( const std::bad_alloc & )
+			{
+				entries_.clear( );
+			}
+
+			// Small array, or no memory
+			if ( entries_.empty( ) )
+			{
+				for ( std::size_t i = 0; i < pCount; i++ )
+					pPointers[i].release( );
+				return;
+			}
+
+			// Reset elements
+			for ( std::size_t i = 0; i < pCount; i++ )
+			{
+				_C0DE4UN_POINTERS_TRACE_( RELEASE, pPointers[i].mObject );
+				pPointers[i].mObject = nullptr;
+				pPointers[i].mCounter = nullptr;
+			}
+
+			// One update per counter
+			for ( std::size_t i = 0; i < entries_.size( ); )
+			{
+
+				// Number of elements with the same counter
+				std::size_t last_( i + 1 );
+				while ( last_ < entries_.size( ) && entries_[last_].mCounter == entries_[i].mCounter )
+					last_++;
+
+				// Last references
+				if ( ( entries_[i].mCounter->mCounter -= static_cast<unsigned short>( last_ - i ) ) < 1 )
+				{
+					_C0DE4UN_POINTERS_TRACE_( FREE, entries_[i].mObject );
+					_C0DE4UN_POINTERS_BORROW_CHECK_( entries_[i].mObject );
+					fast_ptr<T>::destroy( entries_[i].mObject, entries_[i].mCounter );
+				}
+
+				i = last_;
+
+			}
+
+		}
+
+		/*
+		 * Copies elements, without counting. (!) Only after #retain.
+		 *
+		 * @param pSource - elements to copy.
+		 * @param pCount - number of elements.
+		 * @param pDestination - null elements, to set.
+		*/
+		static void adopt( const fast_ptr<T> *const pSource, const std::size_t pCount, fast_ptr<T> *const pDestination ) noexcept
+		{
+
+			// Copy
+			for ( std::size_t i = 0; i < pCount; i++ )
+			{
+				pDestination[i].mObject = pSource[i].mObject;
+				pDestination[i].mCounter = pSource[i].mCounter;
+			}
+
+		}
+
+		/* Returns non-null & not immortal elements, sorted by counter */
+		static std::vector<fast_ptr_entry> group( const fast_ptr<T> *const pPointers, const std::size_t pCount )
+		{
+
+			// Collect
+			std::vector<fast_ptr_entry> result_;
+			result_.reserve( pCount );
+			for ( std::size_t i = 0; i < pCount; i++ )
+			{
+				if ( pPointers[i].mCounter != nullptr && !pPointers[i].mCounter->isImmortal( ) )
+					result_.push_back( fast_ptr_entry{ pPointers[i].mCounter, pPointers[i].mObject } );
+			}
+
+			// Sort
+			std::sort( result_.begin( ), result_.end( ) );
+
+			// Return result
+			return( result_ );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	// ===========================================================
+	// Methods
+	// ===========================================================
+
+	/*
+	 * Adds references to every element's object, one counter update per object.
+	 *
+	 * (?) For fan-out: retain_n( src, n, workers ), then adopt_n( src, n, dst ) per worker.
+	 * (!) Counter is 16-bit: object can have up to FAST_PTR_IMMORTAL - 1 references.
+	 * If any object would exceed it, no references are added & std::overflow_error
+	 * is thrown.
+	 *
+	 * @param pPointers - elements, can be null.
+	 * @param pCount - number of elements.
+	 * @param pReferences - references to add per element.
+	 * @throws - std::bad_alloc, std::overflow_error.
+	*/
+	template <typename T>
+	inline void retain_n( const fast_ptr<T> *const pPointers, const std::size_t pCount, const unsigned int pReferences = 1 )
+	{ fast_ptr_bulk<T>::retain( pPointers, pCount, pReferences ); }
+
+	/*
+	 * Releases every element, one counter update per object. Elements become null.
+	 *
+	 * @param pPointers - elements, can be null.
+	 * @param pCount - number of elements.
+	*/
+	template <typename T>
+	inline void release_n( fast_ptr<T> *const pPointers, const std::size_t pCount ) noexcept
+	{ fast_ptr_bulk<T>::release( pPointers, pCount ); }
+
+	/*
+	 * Copies elements without counting, references must be added by #retain_n.
+	 *
+	 * @param pSource - elements to copy.
+	 * @param pCount - number of elements.
+	 * @param pDestination - null elements, to set.
+	*/
+	template <typename T>
+	inline void adopt_n( const fast_ptr<T> *const pSource, const std::size_t pCount, fast_ptr<T> *const pDestination ) noexcept
+	{ fast_ptr_bulk<T>::adopt( pSource, pCount, pDestination ); }
+
+	/*
+	 * Copies elements, sharing objects, one counter update per object.
+	 *
+	 * @param pSource - elements to copy.
+	 * @param pCount - number of elements.
+	 * @param pDestination - null elements, to set.
+	 * @throws - std::bad_alloc, std::overflow_error (see #retain_n).
+	*/
+	template <typename T>
+	inline void copy_n( const fast_ptr<T> *const pSource, const std::size_t pCount, fast_ptr<T> *const pDestination )
+	{
+
+		// Add references first, can throw
+		fast_ptr_bulk<T>::retain( pSource, pCount, 1 );
+
+		// Copy
+		fast_ptr_bulk<T>::adopt( pSource, pCount, pDestination );
+
+	}
+
+	// ===========================================================
+	// Fields
+	// ===========================================================
+
+	/* Definition of the constants (C++ 11) */
+	template <typename T>
+	constexpr std::size_t fast_ptr_bulk<T>::GROUP_THRESHOLD;
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_FAST_PTR_BULK_HXX_
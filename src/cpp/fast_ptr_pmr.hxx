@@ -0,0 +1,166 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 17
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_FAST_PTR_PMR_HXX_
+#define _C0DE4UN_FAST_PTR_PMR_HXX_
+
+// Polymorphic memory resources (C++ 17)
+#if ( __cplusplus >= 201703L || ( defined( _MSVC_LANG ) && _MSVC_LANG >= 201703L ) ) && defined( __has_include )
+#if __has_include( <memory_resource> )
+#define _C0DE4UN_POINTERS_PMR_ENABLED_
+#endif // <memory_resource>
+#endif // C++ 17
+
+#ifdef _C0DE4UN_POINTERS_PMR_ENABLED_
+
+// Include std::nullptr_t
+#include <cstddef>
+
+// Include std::pmr::memory_resource
+#include <memory_resource>
+
+// Include std::aligned_storage
+#include <type_traits>
+
+// Include std::forward
+#include <utility>
+
+// Include placement new
+#include <new>
+
+// Include fast_ptr
+#include "fast_ptr.hxx"
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_FAST_PTR_PMR_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * fast_ptr_pmr_block - control block & object, allocated by memory resource.
+	 *
+	 * (?) Single allocation. Returned to the same resource, when last fast_ptr
+	 * instance released.
+	*/
+	template <typename T>
+	struct fast_ptr_pmr_block final : public fast_ptr_block
+	{
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Memory resource, allocated this block */
+		std::pmr::memory_resource * mResource;
+
+		/* Object storage */
+		typename std::aligned_storage<sizeof( T ), alignof( T )>::type mStorage;
+
+		// ===========================================================
+		// Constructor
+		// ===========================================================
+
+		/* fast_ptr_pmr_block constructor */
+		explicit fast_ptr_pmr_block( std::pmr::memory_resource *const pResource ) noexcept
+			: fast_ptr_block( &fast_ptr_pmr_block<T>::release ),
+			mResource( pResource ),
+			mStorage( )
+		{
+		}
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Destroys object & returns block to the resource */
+		static void release( fast_ptr_block *const pBlock, void *const pObject )
+		{
+
+			// Block
+			fast_ptr_pmr_block<T> *const block_lp( static_cast<fast_ptr_pmr_block<T>*>( pBlock ) );
+			std::pmr::memory_resource *const resource_lp( block_lp->mResource );
+
+			// Destroy
+			static_cast<T*>( pObject )->~T( );
+			block_lp->~fast_ptr_pmr_block<T>( );
+
+			// Deallocate
+			resource_lp->deallocate( block_lp, sizeof( fast_ptr_pmr_block<T> ), alignof( fast_ptr_pmr_block<T> ) );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	// ===========================================================
+	// Methods
+	// ===========================================================
+
+	/*
+	 * Constructs object, control block & object are allocated (together) by the
+	 * given memory resource, & returned to it on final release.
+	 *
+	 * (?) Resource must outlive all instances. For monotonic resources,
+	 * memory is reclaimed in bulk, when resource is released.
+	 * (?) fast_ptr only: rel_ptr registries are process-wide & shared by all
+	 * resources, so their entries can't be isolated per resource.
+	 *
+	 * @param pResource - memory resource, default resource if null.
+	 * @param pArgs - object constructor arguments.
+	 * @return - fast_ptr.
+	 * @throws - std::bad_alloc, or object constructor exception.
+	*/
+	template <typename T, typename... Args>
+	inline fast_ptr<T> allocate_fast( std::pmr::memory_resource * pResource, Args&&... pArgs )
+	{
+
+		// Resource
+		if ( pResource == nullptr )
+			pResource = std::pmr::get_default_resource( );
+
+		// Allocate
+		void *const memory_lp( pResource->allocate( sizeof( fast_ptr_pmr_block<T> ), alignof( fast_ptr_pmr_block<T> ) ) );
+		fast_ptr_pmr_block<T> *const block_lp( new( memory_lp ) fast_ptr_pmr_block<T>( pResource ) );
+
+		// Construct Object
+		T * object_lp( nullptr );
+		try
+		{
+			object_lp = new( &block_lp->mStorage ) T( std::forward<Args>( pArgs )... );
+		}
+		catch ( ... )
+		{
+			block_lp->~fast_ptr_pmr_block<T>( );
+			pResource->deallocate( memory_lp, sizeof( fast_ptr_pmr_block<T> ), alignof( fast_ptr_pmr_block<T> ) );
+			throw;
+		}
+
+		// Return result
+		return( fast_ptr<T>( object_lp, block_lp ) );
+
+	}
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // _C0DE4UN_POINTERS_PMR_ENABLED_
+
+#endif // !_C0DE4UN_FAST_PTR_PMR_HXX_
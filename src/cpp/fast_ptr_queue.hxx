@@ -0,0 +1,334 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_FAST_PTR_QUEUE_HXX_
+#define _C0DE4UN_FAST_PTR_QUEUE_HXX_
+
+// Include std::size_t
+#include <cstddef>
+
+// Include std::atomic
+#include <atomic>
+
+// Include fast_ptr
+#include "fast_ptr.hxx"
+
+// Include CACHE_LINE_SIZE
+#include "ptr_layout.hxx"
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_FAST_PTR_QUEUE_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * fast_ptr_queue - bounded lock-free multi-producer multi-consumer queue
+	 * of fast_ptr (Vyukov's array queue).
+	 *
+	 * Pointers are moved through the slots: object & control block addresses
+	 * are transferred, without counters changes. Batch operations claim range
+	 * of slots with single CAS.
+	 *
+	 * (?) Each slot has sequence number: slot is free for producer of position
+	 * N, when sequence is N, & ready for consumer, when sequence is N + 1.
+	 * (?) Pointers, left in the queue, are released by destructor.
+	 *
+	 * @thread_safety - #push & #pop methods are thread-safe, lock-free.
+	 * @version 0.1.0
+	*/
+	template <typename T>
+	class fast_ptr_queue final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Types
+		// ===========================================================
+
+		/* Slot */
+		struct queue_slot
+		{
+
+			/* Position, which can use slot */
+			std::atomic<std::size_t> mSequence;
+
+			/* Object */
+			T * mObject;
+
+			/* Control block */
+			fast_ptr_block * mCounter;
+
+		};
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Slots */
+		queue_slot *const mSlots;
+
+		/* Slots mask, capacity - 1 */
+		const std::size_t mMask;
+
+		/* Padding, positions are changed by different threads */
+		char mPadding0[CACHE_LINE_SIZE];
+
+		/* Next producer position */
+		std::atomic<std::size_t> mEnqueue;
+
+		/* Padding */
+		char mPadding1[CACHE_LINE_SIZE];
+
+		/* Next consumer position */
+		std::atomic<std::size_t> mDequeue;
+
+		/* Padding */
+		char mPadding2[CACHE_LINE_SIZE];
+
+		// ===========================================================
+		// Deleted
+		// ===========================================================
+
+		/* @deleted fast_ptr_queue const copy constructor */
+		fast_ptr_queue( const fast_ptr_queue & ) = delete;
+
+		/* @deleted fast_ptr_queue const copy assignment operator */
+		fast_ptr_queue & operator=( const fast_ptr_queue & ) = delete;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Returns capacity, rounded up to power of 2 */
+		static const std::size_t roundCapacity( const std::size_t pCapacity ) noexcept
+		{
+
+			std::size_t result_( 2 );
+			while ( result_ < pCapacity )
+				result_ <<= 1;
+
+			// Return result
+			return( result_ );
+
+		}
+
+		/*
+		 * Claims range of slots.
+		 *
+		 * @param pPosition - producer, or consumer position.
+		 * @param pReady - 0 for producer (slot is free), 1 for consumer (slot is filled).
+		 * @param pCount - max number of slots.
+		 * @param pFirst - first claimed position, to set.
+		 * @return - number of claimed slots, 0 if queue is full (empty).
+		*/
+		const std::size_t claim( std::atomic<std::size_t> & pPosition, const std::size_t pReady, const std::size_t pCount, std::size_t & pFirst ) noexcept
+		{
+
+			std::size_t position_( pPosition.load( std::memory_order_relaxed ) );
+			while ( true )
+			{
+
+				// Count available slots. Slot can't become unavailable, until its position is claimed.
+				std::size_t count_( 0 );
+				while ( count_ < pCount && mSlots[( position_ + count_ ) & mMask].mSequence.load( std::memory_order_acquire ) == position_ + count_ + pReady )
+					count_++;
+
+				// Full (empty), or position is changed by other thread
+				if ( count_ < 1 )
+				{
+					const std::size_t current_( pPosition.load( std::memory_order_relaxed ) );
+					if ( current_ == position_ )
+						return( 0 );
+					position_ = current_;
+					continue;
+				}
+
+				// Claim
+				if ( pPosition.compare_exchange_weak( position_, position_ + count_, std::memory_order_relaxed ) )
+				{
+					pFirst = position_;
+					return( count_ );
+				}
+
+			}
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructor & destructor
+		// ===========================================================
+
+		/*
+		 * fast_ptr_queue constructor
+		 *
+		 * @param pCapacity - max number of pointers, rounded up to power of 2.
+		 * @throws - std::bad_alloc.
+		*/
+		explicit fast_ptr_queue( const std::size_t pCapacity )
+			: mSlots( new queue_slot[roundCapacity( pCapacity )] ),
+			mMask( roundCapacity( pCapacity ) - 1 ),
+			mEnqueue( 0 ),
+			mDequeue( 0 )
+		{
+
+			// Slot N is free for position N
+			for ( std::size_t i = 0; i <= mMask; i++ )
+			{
+				mSlots[i].mSequence.store( i, std::memory_order_relaxed );
+				mSlots[i].mObject = nullptr;
+				mSlots[i].mCounter = nullptr;
+			}
+
+		}
+
+		/* fast_ptr_queue destructor, releases pointers, left in the queue */
+		~fast_ptr_queue( ) noexcept
+		{
+
+			fast_ptr<T> pointer_;
+			while ( pop( pointer_ ) )
+				pointer_.reset( );
+
+			delete[] mSlots;
+
+		}
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/* Returns max number of pointers */
+		const std::size_t capacity( ) const noexcept
+		{ return( mMask + 1 ); }
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Moves pointer to the queue.
+		 *
+		 * @param pPointer - pointer, becomes null, if added.
+		 * @return - false, if queue is full.
+		 * @thread_safety - lock-free.
+		*/
+		const bool push( fast_ptr<T> & pPointer ) noexcept
+		{ return( pushBatch( &pPointer, 1 ) == 1 ); }
+
+		/*
+		 * Moves pointers to the queue, in order.
+		 *
+		 * @param pPointers - pointers, added become null.
+		 * @param pCount - number of pointers.
+		 * @return - number of added pointers, from the start of array.
+		 * @thread_safety - lock-free.
+		*/
+		const std::size_t pushBatch( fast_ptr<T> *const pPointers, const std::size_t pCount ) noexcept
+		{
+
+			// Claim
+			std::size_t first_( 0 );
+			const std::size_t count_( claim( mEnqueue, 0, pCount, first_ ) );
+
+			// Fill
+			for ( std::size_t i = 0; i < count_; i++ )
+			{
+
+				// Move
+				queue_slot & slot_lr( mSlots[( first_ + i ) & mMask] );
+				slot_lr.mObject = pPointers[i].mObject;
+				slot_lr.mCounter = pPointers[i].mCounter;
+				pPointers[i].mObject = nullptr;
+				pPointers[i].mCounter = nullptr;
+
+				// Ready for consumer
+				slot_lr.mSequence.store( first_ + i + 1, std::memory_order_release );
+
+			}
+
+			// Return result
+			return( count_ );
+
+		}
+
+		/*
+		 * Moves pointer from the queue.
+		 *
+		 * @param pPointer - pointer to set, previous value is released.
+		 * @return - false, if queue is empty.
+		 * @thread_safety - lock-free.
+		*/
+		const bool pop( fast_ptr<T> & pPointer ) noexcept
+		{ return( popBatch( &pPointer, 1 ) == 1 ); }
+
+		/*
+		 * Moves pointers from the queue, in order.
+		 *
+		 * @param pPointers - pointers to set, previous values are released.
+		 * @param pCount - max number of pointers.
+		 * @return - number of pointers, set from the start of array.
+		 * @thread_safety - lock-free.
+		*/
+		const std::size_t popBatch( fast_ptr<T> *const pPointers, const std::size_t pCount ) noexcept
+		{
+
+			// Claim
+			std::size_t first_( 0 );
+			const std::size_t count_( claim( mDequeue, 1, pCount, first_ ) );
+
+			// Take
+			for ( std::size_t i = 0; i < count_; i++ )
+			{
+
+				// Move
+				queue_slot & slot_lr( mSlots[( first_ + i ) & mMask] );
+				T *const object_lp( slot_lr.mObject );
+				fast_ptr_block *const counter_lp( slot_lr.mCounter );
+
+				// Free for producer of the next round
+				slot_lr.mSequence.store( first_ + i + mMask + 1, std::memory_order_release );
+
+				// Set
+				pPointers[i].release( );
+				pPointers[i].mObject = object_lp;
+				pPointers[i].mCounter = counter_lp;
+
+			}
+
+			// Return result
+			return( count_ );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_FAST_PTR_QUEUE_HXX_
@@ -0,0 +1,384 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_FAST_PTR_VECTOR_HXX_
+#define _C0DE4UN_FAST_PTR_VECTOR_HXX_
+
+// Include std::size_t
+#include <cstddef>
+
+// Include std::malloc, std::realloc, std::free
+#include <cstdlib>
+
+// Include std::bad_alloc, placement new
+#include <new>
+
+// Include std::move
+#include <utility>
+
+// Include fast_ptr
+#include "fast_ptr.hxx"
+
+// Include copy_n, release_n
+#include "fast_ptr_bulk.hxx"
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_FAST_PTR_VECTOR_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * fast_ptr_vector - dynamic array of fast_ptr.
+	 *
+	 * Pointers are trivially relocatable, so storage grows & shrinks with realloc
+	 * (no per-element move constructor & destructor calls).
+	 *
+	 * (!) Not thread-safe.
+	 *
+	 * @version 0.1.0
+	*/
+	template <typename T>
+	class fast_ptr_vector final
+	{
+
+		// -------------------------------------------------------- \\
+
+		static_assert( is_trivially_relocatable<fast_ptr<T>>::value, "fast_ptr_vector: fast_ptr must be trivially relocatable" );
+
+		// -------------------------------------------------------- \\
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Elements */
+		fast_ptr<T> * mData;
+
+		/* Number of elements */
+		std::size_t mSize;
+
+		/* Number of allocated elements */
+		std::size_t mCapacity;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Relocates elements to storage of the given capacity.
+		 *
+		 * @param pCapacity - new capacity, not less than size.
+		 * @throws - std::bad_alloc.
+		*/
+		void relocate( const std::size_t pCapacity )
+		{
+
+			// Release storage
+			if ( pCapacity == 0 )
+			{
+				std::free( mData );
+				mData = nullptr;
+				mCapacity = 0;
+				return;
+			}
+
+			// Grow or shrink, elements are copied as bytes
+			void *const data_lp( std::realloc( static_cast<void*>( mData ), pCapacity * sizeof( fast_ptr<T> ) ) );
+			if ( data_lp == nullptr )
+				throw std::bad_alloc( );
+
+			// Set
+			mData = static_cast<fast_ptr<T>*>( data_lp );
+			mCapacity = pCapacity;
+
+		}
+
+		/* Makes space for one more element */
+		void grow( )
+		{
+
+			// Double capacity
+			if ( mSize == mCapacity )
+				relocate( mCapacity > 0 ? mCapacity * 2 : 8 );
+
+		}
+
+		/*
+		 * Makes space for one more element, keeps given element valid.
+		 *
+		 * (?) Element can be stored in this vector (v.push_back( v[0] )), then
+		 * it's moved by reallocation.
+		 *
+		 * @param pElement - element to add.
+		 * @return - element address after reallocation.
+		 * @throws - std::bad_alloc.
+		*/
+		fast_ptr<T> *const grow( fast_ptr<T> *const pElement )
+		{
+
+			// Other storage
+			if ( pElement < mData || pElement >= mData + mSize )
+			{
+				grow( );
+				return( pElement );
+			}
+
+			// Own element, by index
+			const std::size_t index_( static_cast<std::size_t>( pElement - mData ) );
+			grow( );
+			return( mData + index_ );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructors & Destructor
+		// ===========================================================
+
+		/* fast_ptr_vector default constructor */
+		fast_ptr_vector( ) noexcept
+			: mData( nullptr ),
+			mSize( 0 ),
+			mCapacity( 0 )
+		{
+		}
+
+		/* fast_ptr_vector const copy constructor, shares all objects */
+		fast_ptr_vector( const fast_ptr_vector<T> & pOther )
+			: mData( nullptr ),
+			mSize( 0 ),
+			mCapacity( 0 )
+		{
+
+			// Storage
+			reserve( pOther.mSize );
+
+			// Null elements
+			for ( std::size_t i = 0; i < pOther.mSize; i++ )
+				new( mData + i ) fast_ptr<T>( );
+
+			// Copy elements, one counter update per object
+			copy_n( pOther.mData, pOther.mSize, mData );
+			mSize = pOther.mSize;
+
+		}
+
+		/* fast_ptr_vector move constructor */
+		fast_ptr_vector( fast_ptr_vector<T> && pOther ) noexcept
+			: mData( pOther.mData ),
+			mSize( pOther.mSize ),
+			mCapacity( pOther.mCapacity )
+		{
+
+			// Reset moved
+			pOther.mData = nullptr;
+			pOther.mSize = 0;
+			pOther.mCapacity = 0;
+
+		}
+
+		/* fast_ptr_vector destructor */
+		~fast_ptr_vector( ) noexcept
+		{
+
+			// Release objects
+			clear( );
+
+			// Release storage
+			std::free( mData );
+
+		}
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/* Returns number of elements */
+		const std::size_t size( ) const noexcept
+		{ return( mSize ); }
+
+		/* Returns number of allocated elements */
+		const std::size_t capacity( ) const noexcept
+		{ return( mCapacity ); }
+
+		/* Returns true if there are no elements */
+		const bool empty( ) const noexcept
+		{ return( mSize == 0 ); }
+
+		/* Returns elements array */
+		fast_ptr<T> *const data( ) noexcept
+		{ return( mData ); }
+
+		/* Returns first element */
+		fast_ptr<T> *const begin( ) noexcept
+		{ return( mData ); }
+
+		/* Returns element after the last one */
+		fast_ptr<T> *const end( ) noexcept
+		{ return( mData + mSize ); }
+
+		// ===========================================================
+		// Methods & Operators
+		// ===========================================================
+
+		/* fast_ptr_vector const copy assignment operator */
+		fast_ptr_vector<T> & operator=( const fast_ptr_vector<T> & pOther )
+		{
+
+			// Cancel if self-copy
+			if ( this == &pOther )
+				return( *this );
+
+			// Copy, then swap
+			fast_ptr_vector<T> copy_( pOther );
+			swap( copy_ );
+
+			// Return
+			return( *this );
+
+		}
+
+		/* fast_ptr_vector move assignment operator */
+		fast_ptr_vector<T> & operator=( fast_ptr_vector<T> && pOther ) noexcept
+		{
+
+			// Swap, moved instance releases previous elements
+			swap( pOther );
+
+			// Return
+			return( *this );
+
+		}
+
+		/* Exchanges elements with other instance */
+		void swap( fast_ptr_vector<T> & pOther ) noexcept
+		{
+			std::swap( mData, pOther.mData );
+			std::swap( mSize, pOther.mSize );
+			std::swap( mCapacity, pOther.mCapacity );
+		}
+
+		/* Returns element. (!) Index is not checked. */
+		fast_ptr<T> & operator[]( const std::size_t pIndex ) noexcept
+		{ return( mData[pIndex] ); }
+
+		/* Returns element. (!) Index is not checked. */
+		const fast_ptr<T> & operator[]( const std::size_t pIndex ) const noexcept
+		{ return( mData[pIndex] ); }
+
+		/*
+		 * Allocates storage for the given number of elements.
+		 *
+		 * @throws - std::bad_alloc.
+		*/
+		void reserve( const std::size_t pCapacity )
+		{
+
+			// Grow
+			if ( pCapacity > mCapacity )
+				relocate( pCapacity );
+
+		}
+
+		/*
+		 * Releases unused storage.
+		 *
+		 * @throws - std::bad_alloc.
+		*/
+		void shrink_to_fit( )
+		{
+
+			// Shrink
+			if ( mCapacity > mSize )
+				relocate( mSize );
+
+		}
+
+		/*
+		 * Adds element, sharing object.
+		 *
+		 * @throws - std::bad_alloc.
+		*/
+		void push_back( const fast_ptr<T> & pPointer )
+		{
+
+			// Storage
+			const fast_ptr<T> *const pointer_lp( grow( const_cast<fast_ptr<T>*>( &pPointer ) ) );
+
+			// Copy
+			new( mData + mSize ) fast_ptr<T>( *pointer_lp );
+			mSize++;
+
+		}
+
+		/*
+		 * Adds element, moving object.
+		 *
+		 * @throws - std::bad_alloc.
+		*/
+		void push_back( fast_ptr<T> && pPointer )
+		{
+
+			// Storage
+			fast_ptr<T> *const pointer_lp( grow( &pPointer ) );
+
+			// Move
+			new( mData + mSize ) fast_ptr<T>( std::move( *pointer_lp ) );
+			mSize++;
+
+		}
+
+		/* Removes last element. (!) Don't call on empty vector. */
+		void pop_back( ) noexcept
+		{
+
+			// Release
+			mSize--;
+			mData[mSize].~fast_ptr<T>( );
+
+		}
+
+		/* Removes all elements, storage is kept */
+		void clear( ) noexcept
+		{
+
+			// Release, one counter update per object. Elements become null, no destructor needed.
+			release_n( mData, mSize );
+
+			// Reset
+			mSize = 0;
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_FAST_PTR_VECTOR_HXX_
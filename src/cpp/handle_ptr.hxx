@@ -0,0 +1,414 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_HANDLE_PTR_HXX_
+#define _C0DE4UN_HANDLE_PTR_HXX_
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::uint32_t
+#include <cstdint>
+
+// Include std::vector
+#include <vector>
+
+// Include std::forward, std::move
+#include <utility>
+
+// Include ptr_registry
+#include "ptr_registry.hxx"
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_HANDLE_PTR_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * slot_handle - slot index & generation, 8 bytes.
+	 *
+	 * (?) Generation 0 is never used by slots, so zero handle is null.
+	*/
+	struct slot_handle final
+	{
+
+		/* Slot index */
+		std::uint32_t mIndex;
+
+		/* Slot generation, when handle was created */
+		std::uint32_t mGeneration;
+
+		/* Returns true if handles are equal */
+		const bool operator==( const slot_handle & pOther ) const noexcept
+		{ return( mIndex == pOther.mIndex && mGeneration == pOther.mGeneration ); }
+
+		/* Returns true if handles are different */
+		const bool operator!=( const slot_handle & pOther ) const noexcept
+		{ return( !( *this == pOther ) ); }
+
+	};
+
+	/*
+	 * slot_map - objects storage, addressed by generational handles.
+	 *
+	 * Objects are stored contiguously (dense array), for cache-friendly iteration.
+	 * Slots map handles to objects: when object is erased, last object is moved to
+	 * it's place & slot generation is increased, so old handles become stale
+	 * (detected) instead of dangling.
+	 *
+	 * (!) Not thread-safe. Objects addresses change on insert & erase, keep handles.
+	 *
+	 * @version 0.1.0
+	*/
+	template <typename T>
+	class slot_map final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Types
+		// ===========================================================
+
+		/* Slot */
+		struct slot_map_slot
+		{
+
+			/* Generation, odd if slot is used */
+			std::uint32_t mGeneration;
+
+			/* Object index if used, next free slot otherwise */
+			std::uint32_t mObject;
+
+		};
+
+		// ===========================================================
+		// Constants
+		// ===========================================================
+
+		/* End of free slots list */
+		static constexpr std::uint32_t NO_SLOT = 0xFFFFFFFF;
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Objects, contiguous */
+		std::vector<T> mObjects;
+
+		/* Slot index of each object */
+		std::vector<std::uint32_t> mObjectSlots;
+
+		/* Slots */
+		std::vector<slot_map_slot> mSlots;
+
+		/* First free slot */
+		std::uint32_t mFreeSlot;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Reserves space for one more element, capacity is doubled (amortized O(1)).
+		 *
+		 * @param pVector - vector.
+		 * @throws - std::bad_alloc.
+		*/
+		template <typename V>
+		static void grow( std::vector<V> & pVector )
+		{
+
+			if ( pVector.size( ) < pVector.capacity( ) )
+				return;
+
+			pVector.reserve( pVector.capacity( ) > 4 ? pVector.capacity( ) * 2 : 8 );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructor
+		// ===========================================================
+
+		/* slot_map default constructor */
+		slot_map( ) noexcept
+			: mObjects( ),
+			mObjectSlots( ),
+			mSlots( ),
+			mFreeSlot( NO_SLOT )
+		{
+		}
+
+		// ===========================================================
+		// Deleted
+		// ===========================================================
+
+		/* @deleted slot_map const copy constructor */
+		slot_map( const slot_map & ) = delete;
+
+		/* @deleted slot_map const copy assignment operator */
+		slot_map & operator=( const slot_map & ) = delete;
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/*
+		 * Returns object, or null if handle is stale.
+		 *
+		 * @param pHandle - handle.
+		 * @return - object address, valid until next insert or erase.
+		*/
+		T *const get( const slot_handle pHandle ) noexcept
+		{
+
+			// Invalid index
+			if ( pHandle.mIndex >= mSlots.size( ) )
+				return( nullptr );
+
+			// Slot
+			const slot_map_slot & slot_lr( mSlots[pHandle.mIndex] );
+
+			// Return result
+			return( slot_lr.mGeneration == pHandle.mGeneration ? &mObjects[slot_lr.mObject] : nullptr );
+
+		}
+
+		/* Returns number of objects */
+		const std::size_t size( ) const noexcept
+		{ return( mObjects.size( ) ); }
+
+		/* Returns first object, objects are contiguous */
+		T *const begin( ) noexcept
+		{ return( mObjects.data( ) ); }
+
+		/* Returns address after the last object */
+		T *const end( ) noexcept
+		{ return( mObjects.data( ) + mObjects.size( ) ); }
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Constructs object.
+		 *
+		 * @param pArgs - object constructor arguments.
+		 * @return - handle.
+		 * @throws - std::bad_alloc, or object constructor exception.
+		*/
+		template <typename... Args>
+		slot_handle emplace( Args&&... pArgs )
+		{
+
+			// Reserve, so next operations can't throw
+			grow( mObjectSlots );
+			if ( mFreeSlot == NO_SLOT )
+				grow( mSlots );
+
+			// Construct Object
+			mObjects.emplace_back( std::forward<Args>( pArgs )... );
+
+			// Take free slot, or add new one
+			std::uint32_t index_( mFreeSlot );
+			if ( index_ == NO_SLOT )
+			{
+				index_ = static_cast<std::uint32_t>( mSlots.size( ) );
+				mSlots.push_back( slot_map_slot{ 0, NO_SLOT } );
+			}
+			slot_map_slot & slot_lr( mSlots[index_] );
+			mFreeSlot = slot_lr.mObject;
+
+			// Use slot
+			slot_lr.mGeneration++;
+			slot_lr.mObject = static_cast<std::uint32_t>( mObjects.size( ) - 1 );
+			mObjectSlots.push_back( index_ );
+
+			// Return result
+			return( slot_handle{ index_, slot_lr.mGeneration } );
+
+		}
+
+		/*
+		 * Destroys object, handle becomes stale.
+		 *
+		 * @param pHandle - handle.
+		 * @return - false if handle is already stale.
+		*/
+		const bool erase( const slot_handle pHandle )
+		{
+
+			// Stale
+			if ( get( pHandle ) == nullptr )
+				return( false );
+
+			// Slot
+			slot_map_slot & slot_lr( mSlots[pHandle.mIndex] );
+			const std::uint32_t object_( slot_lr.mObject );
+
+			// Move last object to the erased one place
+			const std::uint32_t last_( static_cast<std::uint32_t>( mObjects.size( ) - 1 ) );
+			if ( object_ != last_ )
+			{
+				mObjects[object_] = std::move( mObjects[last_] );
+				mObjectSlots[object_] = mObjectSlots[last_];
+				mSlots[mObjectSlots[object_]].mObject = object_;
+			}
+
+			// Destroy
+			mObjects.pop_back( );
+			mObjectSlots.pop_back( );
+
+			// Free slot, generation becomes even
+			slot_lr.mGeneration++;
+			slot_lr.mObject = mFreeSlot;
+			mFreeSlot = pHandle.mIndex;
+
+			// Return result
+			return( true );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	/*
+	 * handle_ptr - 8-byte handle to object, stored in process-wide slot_map<T>.
+	 *
+	 * Non-owning (as weak pointer): object lives until #destroy, after that all
+	 * handles to it return null instead of dangling. Dereference is an array index.
+	 *
+	 * (!) Not thread-safe, same as slot_map.
+	 *
+	 * @version 0.1.0
+	*/
+	template <typename T>
+	class handle_ptr final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Handle */
+		slot_handle mHandle;
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructor
+		// ===========================================================
+
+		/* handle_ptr constructor */
+		explicit handle_ptr( const slot_handle pHandle = slot_handle{ 0, 0 } ) noexcept
+			: mHandle( pHandle )
+		{
+		}
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/* Returns process-wide storage of T objects */
+		static slot_map<T> & getStorage( )
+		{ return( ptr_registry<slot_map<T>>::get( ) ); }
+
+		/* Returns handle */
+		const slot_handle getHandle( ) const noexcept
+		{ return( mHandle ); }
+
+		// ===========================================================
+		// Methods & Operators
+		// ===========================================================
+
+		/*
+		 * Constructs object in the storage.
+		 *
+		 * @param pArgs - object constructor arguments.
+		 * @return - handle_ptr.
+		 * @throws - std::bad_alloc, or object constructor exception.
+		*/
+		template <typename... Args>
+		static handle_ptr<T> make( Args&&... pArgs )
+		{ return( handle_ptr<T>( getStorage( ).emplace( std::forward<Args>( pArgs )... ) ) ); }
+
+		/*
+		 * Destroys object, all handles to it become null.
+		 *
+		 * @return - false if object was already destroyed.
+		*/
+		const bool destroy( )
+		{ return( getStorage( ).erase( mHandle ) ); }
+
+		/* Returns 'raw-pointer', or null if object is destroyed. Valid until next make or destroy. */
+		T *const get( ) const
+		{ return( mHandle.mGeneration != 0 ? getStorage( ).get( mHandle ) : nullptr ); }
+
+		/* Returns 'raw-pointer' to the object instance, can be null. Same as #get. */
+		T *const operator*( ) const
+		{ return( get( ) ); }
+
+		/* Pointer address access operator */
+		T *const operator->( ) const
+		{ return( get( ) ); }
+
+		/* Returns true if object is destroyed, or handle is null */
+		const bool operator==( std::nullptr_t ) const
+		{ return( get( ) == nullptr ); }
+
+		/* Returns true if object is alive */
+		const bool operator!=( std::nullptr_t ) const
+		{ return( get( ) != nullptr ); }
+
+		/* Returns true if this instance refers same object as given one. */
+		const bool operator==( const handle_ptr<T> & pOther ) const noexcept
+		{ return( mHandle == pOther.mHandle ); }
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	// ===========================================================
+	// Fields
+	// ===========================================================
+
+	/* Definition of the constants (C++ 11) */
+	template <typename T>
+	constexpr std::uint32_t slot_map<T>::NO_SLOT;
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_HANDLE_PTR_HXX_
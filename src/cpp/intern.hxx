@@ -0,0 +1,297 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_INTERN_HXX_
+#define _C0DE4UN_INTERN_HXX_
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::hash, std::equal_to
+#include <functional>
+
+// Include std::unordered_map
+#include <unordered_map>
+
+// Include std::mutex, std::lock_guard
+#include <mutex>
+
+// Include std::overflow_error
+#include <stdexcept>
+
+// Include std::decay
+#include <type_traits>
+
+// Include std::forward
+#include <utility>
+
+// Include fast_ptr
+#include "fast_ptr.hxx"
+
+// Include ptr_registry
+#include "ptr_registry.hxx"
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_INTERN_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * intern_table - process-wide registry of canonical values (hash-consing).
+	 *
+	 * Equal values (by H & E) share single immutable instance, so values can be
+	 * compared by address. Value & fast_ptr control block are single allocation,
+	 * entry is removed, when last fast_ptr released.
+	 *
+	 * (?) Table is created on first use, see ptr_registry.
+	 *
+	 * @thread_safety - thread-safe, thread-lock used.
+	 * @version 0.1.0
+	*/
+	template <typename T, typename H = std::hash<T>, typename E = std::equal_to<T>>
+	class intern_table final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Types
+		// ===========================================================
+
+		/* Control block & canonical value */
+		struct intern_block final : public fast_ptr_block
+		{
+
+			/* Value */
+			const T mValue;
+
+			/* intern_block constructor */
+			template <typename V>
+			explicit intern_block( V && pValue )
+				: fast_ptr_block( &intern_table::release ),
+				mValue( std::forward<V>( pValue ) )
+			{
+			}
+
+		};
+
+		/* Hash of the value, by address */
+		struct value_hash
+		{
+			const std::size_t operator()( const T *const pValue ) const
+			{ return( H( )( *pValue ) ); }
+		};
+
+		/* Equality of the values, by address */
+		struct value_equal
+		{
+			const bool operator()( const T *const pFirst, const T *const pSecond ) const
+			{ return( E( )( *pFirst, *pSecond ) ); }
+		};
+
+		/* Type-Alias for entries */
+		using values_t = std::unordered_map<const T*, intern_block*, value_hash, value_equal>;
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Thread-lock */
+		std::mutex mMutex;
+
+		/* Blocks, by value */
+		values_t mValues;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Adds instance, if block is still referenced. Immortal counter is not changed.
+		 *
+		 * @return - false, if last instance is released & block waits for removal.
+		 * @throws - std::overflow_error, if block has FAST_PTR_IMMORTAL - 1 instances.
+		*/
+		static const bool acquire( intern_block *const pBlock )
+		{
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+			unsigned short count_( pBlock->mCounter.load( ) );
+			do
+			{
+				if ( count_ < 1 )
+					return( false );
+				if ( count_ == FAST_PTR_IMMORTAL )
+					return( true );
+				if ( count_ == FAST_PTR_IMMORTAL - 1 )
+					throw std::overflow_error( "intern_table::intern - counter overflow" );
+			}
+			while ( !pBlock->mCounter.compare_exchange_weak( count_, static_cast<unsigned short>( count_ + 1 ) ) );
+#else
+			if ( pBlock->mCounter < 1 )
+				return( false );
+			if ( pBlock->isImmortal( ) )
+				return( true );
+			if ( pBlock->mCounter == FAST_PTR_IMMORTAL - 1 )
+				throw std::overflow_error( "intern_table::intern - counter overflow" );
+			pBlock->mCounter++;
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+			// Return OK
+			return( true );
+
+		}
+
+		/* Removes entry & deletes block, after last instance released */
+		static void release( fast_ptr_block *const pBlock, void *const )
+		{
+
+			// Block
+			intern_block *const block_lp( static_cast<intern_block*>( pBlock ) );
+
+			// Remove entry, if it's not replaced by new value
+			{
+				intern_table & table_lr( ptr_registry<intern_table>::get( ) );
+				std::lock_guard<std::mutex> lock_( table_lr.mMutex );
+				typename values_t::iterator entry_( table_lr.mValues.find( &block_lp->mValue ) );
+				if ( entry_ != table_lr.mValues.end( ) && entry_->second == block_lp )
+					table_lr.mValues.erase( entry_ );
+			}
+
+			// Delete value, without thread-lock
+			delete block_lp;
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/*
+		 * Returns number of canonical values.
+		 *
+		 * @throws - std::bad_alloc, mutex.
+		*/
+		static const std::size_t size( )
+		{
+
+			// Table
+			intern_table & table_lr( ptr_registry<intern_table>::get( ) );
+			std::lock_guard<std::mutex> lock_( table_lr.mMutex );
+
+			// Return result
+			return( table_lr.mValues.size( ) );
+
+		}
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Returns canonical instance of the value. Value is copied (moved) only,
+		 * if there is no equal value in the table.
+		 *
+		 * @param pValue - value.
+		 * @return - fast_ptr to the canonical value.
+		 * @throws - std::bad_alloc, mutex, T constructor exception, or
+		 * std::overflow_error, if value has FAST_PTR_IMMORTAL - 1 instances.
+		*/
+		template <typename V>
+		static fast_ptr<const T> intern( V && pValue )
+		{
+
+			// Table
+			intern_table & table_lr( ptr_registry<intern_table>::get( ) );
+			std::lock_guard<std::mutex> lock_( table_lr.mMutex );
+
+			// Search
+			const T & value_lr( pValue );
+			typename values_t::iterator entry_( table_lr.mValues.find( &value_lr ) );
+			if ( entry_ != table_lr.mValues.end( ) )
+			{
+
+				// Share
+				intern_block *const block_lp( entry_->second );
+				if ( acquire( block_lp ) )
+					return( fast_ptr<const T>( &block_lp->mValue, block_lp ) );
+
+				// Released, replace
+				table_lr.mValues.erase( entry_ );
+
+			}
+
+			// Add
+			intern_block *const block_lp( new intern_block( std::forward<V>( pValue ) ) );
+			try
+			{
+				table_lr.mValues.emplace( &block_lp->mValue, block_lp );
+			}
+			catch ( ... )
+			{
+				delete block_lp;
+				throw;
+			}
+
+			// Return result
+			return( fast_ptr<const T>( &block_lp->mValue, block_lp ) );
+
+		}
+
+		/*
+		 * Destroys table. Next use creates new one.
+		 *
+		 * (!) Call only when all interned values are released.
+		 *
+		 * @throws - mutex.
+		*/
+		static void shutdown( )
+		{ ptr_registry<intern_table>::shutdown( ); }
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	// ===========================================================
+	// Methods
+	// ===========================================================
+
+	/*
+	 * Returns canonical instance of the value, see intern_table.
+	 *
+	 * @param pValue - value.
+	 * @return - fast_ptr to the canonical value, equal values share address.
+	 * @throws - std::bad_alloc, mutex, T constructor exception, or
+	 * std::overflow_error, see intern_table::intern.
+	*/
+	template <typename T>
+	inline fast_ptr<const typename std::decay<T>::type> intern( T && pValue )
+	{ return( intern_table<typename std::decay<T>::type>::intern( std::forward<T>( pValue ) ) ); }
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_INTERN_HXX_
@@ -65,6 +65,9 @@ int main( )
 	// 
 	trel_ptr_test( );
 
+	// Release 'relative pointers' cache
+	c0de4un::typeless_rel_ptr_shutdown( );
+
 	// Print Bye to Console
 	std::cout << "Simple Pointer Example Finished" << std::endl;
 	
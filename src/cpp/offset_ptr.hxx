@@ -0,0 +1,582 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_OFFSET_PTR_HXX_
+#define _C0DE4UN_OFFSET_PTR_HXX_
+
+// Include std::size_t, std::ptrdiff_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::uint64_t, std::uintptr_t
+#include <cstdint>
+
+// Include std::atomic
+#include <atomic>
+
+// Include placement new, std::bad_alloc
+#include <new>
+
+// Include std::forward
+#include <utility>
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_OFFSET_PTR_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * offset_ptr - position-independent pointer.
+	 *
+	 * Stores offset from own address to the object, so pointer & object can be
+	 * stored in a memory-mapped file or shared-memory segment, which is mapped at
+	 * different addresses by different processes.
+	 *
+	 * (!) Pointer & object must be in the same segment (mapping).
+	 * (!) Copy recalculates offset, so pointer can't be copied with memcpy.
+	 *
+	 * @version 0.1.0
+	*/
+	template <typename T>
+	class offset_ptr final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constants
+		// ===========================================================
+
+		/* Offset, used for nullptr (0 is a pointer to itself) */
+		static constexpr std::ptrdiff_t NULL_OFFSET = 1;
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Offset (bytes) from this instance to the object */
+		std::ptrdiff_t mOffset;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Calculates offset from this instance to the given object */
+		std::ptrdiff_t offsetTo( const T *const pObject ) const noexcept
+		{
+
+			// Null
+			if ( pObject == nullptr )
+				return( NULL_OFFSET );
+
+			// Offset
+			return( static_cast<std::ptrdiff_t>( reinterpret_cast<std::uintptr_t>( pObject ) - reinterpret_cast<std::uintptr_t>( this ) ) );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructors
+		// ===========================================================
+
+		/*
+		 * offset_ptr Constructor with initial value
+		 *
+		 * @param pObject - object address in the same segment.
+		*/
+		offset_ptr( T *const pObject = nullptr ) noexcept
+			: mOffset( NULL_OFFSET )
+		{ mOffset = offsetTo( pObject ); }
+
+		/* offset_ptr const copy constructor */
+		offset_ptr( const offset_ptr<T> & pOther ) noexcept
+			: mOffset( NULL_OFFSET )
+		{ mOffset = offsetTo( pOther.get( ) ); }
+
+		/* offset_ptr const copy assignment operator */
+		offset_ptr<T> & operator=( const offset_ptr<T> & pOther ) noexcept
+		{
+
+			// Recalculate offset
+			mOffset = offsetTo( pOther.get( ) );
+
+			// Return
+			return( *this );
+
+		}
+
+		/* Assign (set) object address */
+		offset_ptr<T> & operator=( T *const pObject ) noexcept
+		{
+
+			// Recalculate offset
+			mOffset = offsetTo( pObject );
+
+			// Return
+			return( *this );
+
+		}
+
+		// ===========================================================
+		// Methods & Operators
+		// ===========================================================
+
+		/* Returns 'raw-pointer', valid in the current process mapping */
+		T *const get( ) const noexcept
+		{
+
+			// Null
+			if ( mOffset == NULL_OFFSET )
+				return( nullptr );
+
+			// Address
+			return( reinterpret_cast<T*>( reinterpret_cast<std::uintptr_t>( this ) + static_cast<std::uintptr_t>( mOffset ) ) );
+
+		}
+
+		/* Returns 'reference'. (!) Don't call on null-value. */
+		T & getRef( ) const noexcept
+		{ return( *get( ) ); }
+
+		/* Returns 'raw-pointer' to the object instance, can be null. Same as #get. */
+		T *const operator*( ) const noexcept
+		{ return( get( ) ); }
+
+		/* Pointer address access operator */
+		T *const operator->( ) const noexcept
+		{ return( get( ) ); }
+
+		/* Returns true if 'pointer' is nullptr */
+		const bool operator==( std::nullptr_t ) const noexcept
+		{ return( mOffset == NULL_OFFSET ); }
+
+		/* Returns true if 'pointer' is not nullptr */
+		const bool operator!=( std::nullptr_t ) const noexcept
+		{ return( mOffset != NULL_OFFSET ); }
+
+		/* Returns true if this instance stores same object as given one. */
+		const bool operator==( const offset_ptr<T> & pOther ) const noexcept
+		{ return( get( ) == pOther.get( ) ); }
+
+		/* Returns true if given object instance is the same as the stored one. */
+		const bool operator==( T *const pObject ) const noexcept
+		{ return( get( ) == pObject ); }
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	/*
+	 * offset_ptr_data - shared, between shared_offset_ptr instances, data.
+	 *
+	 * (?) Stored in a segment, with the object.
+	*/
+	template <typename T>
+	struct offset_ptr_data final
+	{
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Instances counter, shared between processes */
+		std::atomic<unsigned int> mCounter;
+
+		/* Stored Object Instance */
+		T mObject;
+
+		// ===========================================================
+		// Constructor
+		// ===========================================================
+
+		/* offset_ptr_data constructor */
+		template <typename... Args>
+		explicit offset_ptr_data( Args&&... pArgs )
+			: mCounter( 1 ),
+			mObject( std::forward<Args>( pArgs )... )
+		{
+		}
+
+		// ===========================================================
+		// Deleted
+		// ===========================================================
+
+		/* @deleted offset_ptr_data const copy constructor */
+		offset_ptr_data( const offset_ptr_data & ) = delete;
+
+		/* @deleted offset_ptr_data const copy assignment operator */
+		offset_ptr_data & operator=( const offset_ptr_data & ) = delete;
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	/*
+	 * shared_offset_ptr - position-independent shared pointer.
+	 *
+	 * Counter is stored with the object in the segment, so pointers from different
+	 * processes share it. Object is destroyed by the last instance, but it's memory
+	 * is not returned to the segment (see offset_segment).
+	 *
+	 * @version 0.1.0
+	*/
+	template <typename T>
+	class shared_offset_ptr final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Data */
+		offset_ptr<offset_ptr_data<T>> mData;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Decreases counter & destroys object, if last instance */
+		void release( ) noexcept
+		{
+
+			// Data
+			offset_ptr_data<T> *const data_lp( mData.get( ) );
+
+			// Cancel
+			if ( data_lp == nullptr )
+				return;
+
+			// Destroy Object
+			if ( --data_lp->mCounter == 0 )
+				data_lp->~offset_ptr_data<T>( );
+
+			// Reset
+			mData = nullptr;
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructors & Destructor
+		// ===========================================================
+
+		/*
+		 * shared_offset_ptr constructor.
+		 *
+		 * (?) Takes ownership of the data, counter is not changed.
+		 *
+		 * @param pData - data, created by offset_segment#make.
+		*/
+		explicit shared_offset_ptr( offset_ptr_data<T> *const pData = nullptr ) noexcept
+			: mData( pData )
+		{
+		}
+
+		/* shared_offset_ptr const copy constructor */
+		shared_offset_ptr( const shared_offset_ptr<T> & pOther ) noexcept
+			: mData( pOther.mData )
+		{
+
+			// Increase Pointers-Instances Counter
+			if ( mData != nullptr )
+				mData->mCounter++;
+
+		}
+
+		/* shared_offset_ptr const copy assignment operator */
+		shared_offset_ptr<T> & operator=( const shared_offset_ptr<T> & pOther ) noexcept
+		{
+
+			// Cancel if same data
+			if ( mData == pOther.mData )
+				return( *this );
+
+			// Increase new object counter first
+			if ( pOther.mData != nullptr )
+				pOther.mData->mCounter++;
+
+			// Release previous object
+			release( );
+
+			// Copy Data
+			mData = pOther.mData;
+
+			// Return
+			return( *this );
+
+		}
+
+		/* shared_offset_ptr destructor */
+		~shared_offset_ptr( ) noexcept
+		{ release( ); }
+
+		// ===========================================================
+		// Methods & Operators
+		// ===========================================================
+
+		/* Releases object */
+		void reset( ) noexcept
+		{ release( ); }
+
+		/* Returns 'raw-pointer', valid in the current process mapping */
+		T *const get( ) const noexcept
+		{ return( mData != nullptr ? &mData->mObject : nullptr ); }
+
+		/* Returns 'reference'. (!) Don't call on null-value. */
+		T & getRef( ) const noexcept
+		{ return( mData->mObject ); }
+
+		/* Returns 'raw-pointer' to the object instance, can be null. Same as #get. */
+		T *const operator*( ) const noexcept
+		{ return( get( ) ); }
+
+		/* Pointer address access operator */
+		T *const operator->( ) const noexcept
+		{ return( get( ) ); }
+
+		/* Returns number of pointer-'instances' */
+		const unsigned int count( ) const noexcept
+		{ return( mData != nullptr ? mData->mCounter.load( ) : 0 ); }
+
+		/* Returns true if 'pointer' is nullptr */
+		const bool operator==( std::nullptr_t ) const noexcept
+		{ return( mData == nullptr ); }
+
+		/* Returns true if 'pointer' is not nullptr */
+		const bool operator!=( std::nullptr_t ) const noexcept
+		{ return( mData != nullptr ); }
+
+		/* Returns true if this instance stores same object as given one. */
+		const bool operator==( const shared_offset_ptr<T> & pOther ) const noexcept
+		{ return( mData == pOther.mData ); }
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	/*
+	 * offset_segment - allocator over memory, shared between processes (mmap'd
+	 * file, POSIX/Win32 shared-memory).
+	 *
+	 * Segment starts with a header (allocation offset & root object), so other
+	 * processes can attach to it & find objects graph. Memory is bump-allocated
+	 * & never returned, segment is intended for large read-mostly data.
+	 *
+	 * @thread_safety - allocation is lock-free, atomic (address-free) used.
+	 * @version 0.1.0
+	*/
+	class offset_segment final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Types
+		// ===========================================================
+
+		/* Segment header, stored in the segment memory */
+		struct offset_segment_header
+		{
+
+			/* Format tag */
+			std::uint64_t mMagic;
+
+			/* Segment size (bytes) */
+			std::uint64_t mSize;
+
+			/* Used bytes, including header */
+			std::atomic<std::uint64_t> mUsed;
+
+			/* Root object */
+			offset_ptr<char> mRoot;
+
+		};
+
+		// ===========================================================
+		// Constants
+		// ===========================================================
+
+		/* Header format tag */
+		static constexpr std::uint64_t MAGIC = 0x31474553544652ULL; // "RFTSEG1"
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Header, at the segment start */
+		offset_segment_header * mHeader;
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructor
+		// ===========================================================
+
+		/*
+		 * offset_segment constructor.
+		 *
+		 * (?) Attaches to already initialized segment, or initializes new one.
+		 * (!) Atomics must be lock-free, to be shared between processes.
+		 *
+		 * @param pMemory - mapped memory, aligned at least to 8 bytes.
+		 * @param pSize - mapped memory size (bytes).
+		 * @param pCreate - initialize new segment (only first process).
+		*/
+		offset_segment( void *const pMemory, const std::size_t pSize, const bool pCreate ) noexcept
+			: mHeader( static_cast<offset_segment_header*>( pMemory ) )
+		{
+
+			// Lock-free atomics only
+			static_assert( ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2, "offset_segment requires lock-free atomics" );
+
+			// Cancel
+			if ( !pCreate )
+				return;
+
+			// Initialize Header
+			offset_segment_header *const header_lp( new( pMemory ) offset_segment_header( ) );
+			header_lp->mMagic = MAGIC;
+			header_lp->mSize = pSize;
+			header_lp->mUsed = sizeof( offset_segment_header );
+			header_lp->mRoot = nullptr;
+
+		}
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/* Returns true if segment is initialized */
+		const bool isValid( ) const noexcept
+		{ return( mHeader != nullptr && mHeader->mMagic == MAGIC ); }
+
+		/* Returns root object, or null */
+		template <typename T>
+		T *const getRoot( ) const noexcept
+		{ return( reinterpret_cast<T*>( mHeader->mRoot.get( ) ) ); }
+
+		/* Sets root object, stored in the segment */
+		template <typename T>
+		void setRoot( T *const pObject ) noexcept
+		{ mHeader->mRoot = reinterpret_cast<char*>( pObject ); }
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Allocates raw memory from the segment.
+		 *
+		 * @thread_safety - lock-free, can be called from different processes.
+		 * @param pSize - bytes.
+		 * @param pAlignment - alignment, power of 2.
+		 * @return - memory address.
+		 * @throws - std::bad_alloc, if segment is full.
+		*/
+		void *const allocate( const std::size_t pSize, const std::size_t pAlignment )
+		{
+
+			// Segment start
+			const std::uintptr_t begin_( reinterpret_cast<std::uintptr_t>( mHeader ) );
+
+			// Current offset
+			std::uint64_t used_( mHeader->mUsed.load( ) );
+			std::uint64_t address_( 0 );
+
+			// Bump
+			do
+			{
+
+				// Aligned address
+				address_ = ( begin_ + used_ + pAlignment - 1 ) & ~static_cast<std::uint64_t>( pAlignment - 1 );
+
+				// Out of memory
+				if ( address_ + pSize > begin_ + mHeader->mSize )
+					throw std::bad_alloc( );
+
+			}
+			while ( !mHeader->mUsed.compare_exchange_weak( used_, address_ + pSize - begin_ ) );
+
+			// Return result
+			return( reinterpret_cast<void*>( static_cast<std::uintptr_t>( address_ ) ) );
+
+		}
+
+		/*
+		 * Constructs object in the segment.
+		 *
+		 * (!) Object must use only offset pointers to the segment objects.
+		 *
+		 * @param pArgs - object constructor arguments.
+		 * @return - object address.
+		 * @throws - std::bad_alloc, or object constructor exception.
+		*/
+		template <typename T, typename... Args>
+		T *const construct( Args&&... pArgs )
+		{ return( new( allocate( sizeof( T ), alignof( T ) ) ) T( std::forward<Args>( pArgs )... ) ); }
+
+		/*
+		 * Constructs shared object in the segment.
+		 *
+		 * @param pArgs - object constructor arguments.
+		 * @return - shared_offset_ptr, counter = 1.
+		 * @throws - std::bad_alloc, or object constructor exception.
+		*/
+		template <typename T, typename... Args>
+		shared_offset_ptr<T> make( Args&&... pArgs )
+		{ return( shared_offset_ptr<T>( construct<offset_ptr_data<T>>( std::forward<Args>( pArgs )... ) ) ); }
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	// ===========================================================
+	// Fields
+	// ===========================================================
+
+	/* Definition of the constants (C++ 11) */
+	template <typename T>
+	constexpr std::ptrdiff_t offset_ptr<T>::NULL_OFFSET;
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_OFFSET_PTR_HXX_
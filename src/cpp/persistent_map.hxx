@@ -0,0 +1,462 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_PERSISTENT_MAP_HXX_
+#define _C0DE4UN_PERSISTENT_MAP_HXX_
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::uint32_t
+#include <cstdint>
+
+// Include std::vector
+#include <vector>
+
+// Include std::pair
+#include <utility>
+
+// Include std::hash, std::equal_to
+#include <functional>
+
+// Include fast_ptr
+#include "fast_ptr.hxx"
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_PERSISTENT_MAP_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * persistent_map - hash map with structural sharing (HAMT, CHAMP layout).
+	 *
+	 * Node uses 5 bits of the hash per level & stores entries & children
+	 * separately, compressed by bitmaps. Keys with equal hashes are stored in
+	 * collision node, after all hash bits used.
+	 *
+	 * Copy is a snapshot: O(1), shares all nodes through fast_ptr counters.
+	 * Update copies only nodes on the path to the root, which are shared with
+	 * other snapshots, uniquely owned nodes are modified in place.
+	 * Access & updates are O(log32 n).
+	 *
+	 * (!) Node can be shared by up to 65535 snapshots (fast_ptr counter).
+	 * (!) Same instance is not thread-safe, different snapshots are (with
+	 * _C0DE4UN_MULTITHREADING_ENABLED_).
+	 *
+	 * @version 0.1.0
+	*/
+	template <typename K, typename V, typename H = std::hash<K>, typename E = std::equal_to<K>>
+	class persistent_map final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constants
+		// ===========================================================
+
+		/* Hash bits per level */
+		static constexpr unsigned int BITS = 5;
+
+		/* Hash mask per level */
+		static constexpr std::size_t MASK = ( 1 << BITS ) - 1;
+
+		/* Hash bits, levels below are collision nodes */
+		static constexpr unsigned int HASH_BITS = sizeof( std::size_t ) * 8;
+
+		// ===========================================================
+		// Types
+		// ===========================================================
+
+		/* Type-Alias for entry */
+		using entry_t = std::pair<K, V>;
+
+		/* Trie node */
+		struct persistent_map_node
+		{
+
+			/* Slots with entries */
+			std::uint32_t mEntriesMap;
+
+			/* Slots with children */
+			std::uint32_t mChildrenMap;
+
+			/* Entries, in slots order. All entries, for collision node. */
+			std::vector<entry_t> mEntries;
+
+			/* Children, in slots order */
+			std::vector<fast_ptr<persistent_map_node>> mChildren;
+
+			/* persistent_map_node default constructor */
+			persistent_map_node( ) noexcept
+				: mEntriesMap( 0 ),
+				mChildrenMap( 0 ),
+				mEntries( ),
+				mChildren( )
+			{
+			}
+
+		};
+
+		/* Type-Alias for node pointer */
+		using node_ptr = fast_ptr<persistent_map_node>;
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Root node */
+		node_ptr mRoot;
+
+		/* Number of entries */
+		std::size_t mSize;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Returns number of set bits */
+		static const unsigned int popcount( std::uint32_t pBits ) noexcept
+		{
+
+			pBits = pBits - ( ( pBits >> 1 ) & 0x55555555 );
+			pBits = ( pBits & 0x33333333 ) + ( ( pBits >> 2 ) & 0x33333333 );
+
+			// Return result
+			return( static_cast<unsigned int>( ( ( ( pBits + ( pBits >> 4 ) ) & 0x0F0F0F0F ) * 0x01010101 ) >> 24 ) );
+
+		}
+
+		/* Returns index of the slot in compressed array */
+		static const std::size_t index( const std::uint32_t pMap, const std::uint32_t pBit ) noexcept
+		{ return( popcount( pMap & ( pBit - 1 ) ) ); }
+
+		/* Returns slot bit of the hash at the given level */
+		static const std::uint32_t slot( const std::size_t pHash, const unsigned int pShift ) noexcept
+		{ return( static_cast<std::uint32_t>( 1 ) << ( ( pHash >> pShift ) & MASK ) ); }
+
+		/*
+		 * Returns node for modification, copies it, if shared.
+		 *
+		 * (?) Called from the root, so shared parent is copied before children,
+		 * which become shared by the copy.
+		 *
+		 * @throws - std::bad_alloc, or K & V copy exception.
+		*/
+		static persistent_map_node *const edit( node_ptr & pNode )
+		{
+
+			// Create
+			if ( pNode == nullptr )
+				pNode = node_ptr( new persistent_map_node( ) );
+			else if ( pNode.count( ) > 1 ) // Copy shared
+				pNode = node_ptr( new persistent_map_node( pNode.getRef( ) ) );
+
+			// Return result
+			return( pNode.getPtr( ) );
+
+		}
+
+		/* Inserts or replaces entry. Returns true if inserted. */
+		static const bool put( node_ptr & pNode, const std::size_t pHash, const unsigned int pShift, const K & pKey, const V & pValue )
+		{
+
+			// Node
+			persistent_map_node *const node_lp( edit( pNode ) );
+
+			// Collision node
+			if ( pShift >= HASH_BITS )
+			{
+
+				// Replace
+				for ( entry_t & entry_lr : node_lp->mEntries )
+				{
+					if ( E( )( entry_lr.first, pKey ) )
+					{
+						entry_lr.second = pValue;
+						return( false );
+					}
+				}
+
+				// Insert
+				node_lp->mEntries.push_back( entry_t( pKey, pValue ) );
+				return( true );
+
+			}
+
+			// Slot
+			const std::uint32_t bit_( slot( pHash, pShift ) );
+
+			// Entry in the slot
+			if ( ( node_lp->mEntriesMap & bit_ ) != 0 )
+			{
+
+				// Replace
+				const std::size_t entryIndex_( index( node_lp->mEntriesMap, bit_ ) );
+				if ( E( )( node_lp->mEntries[entryIndex_].first, pKey ) )
+				{
+					node_lp->mEntries[entryIndex_].second = pValue;
+					return( false );
+				}
+
+				// Move both entries to the child
+				node_ptr child_;
+				const entry_t & entry_lr( node_lp->mEntries[entryIndex_] );
+				put( child_, H( )( entry_lr.first ), pShift + BITS, entry_lr.first, entry_lr.second );
+				put( child_, pHash, pShift + BITS, pKey, pValue );
+
+				// Replace entry with child
+				node_lp->mChildren.insert( node_lp->mChildren.begin( ) + index( node_lp->mChildrenMap, bit_ ), child_ );
+				node_lp->mChildrenMap |= bit_;
+				node_lp->mEntries.erase( node_lp->mEntries.begin( ) + entryIndex_ );
+				node_lp->mEntriesMap &= ~bit_;
+				return( true );
+
+			}
+
+			// Child in the slot
+			if ( ( node_lp->mChildrenMap & bit_ ) != 0 )
+				return( put( node_lp->mChildren[index( node_lp->mChildrenMap, bit_ )], pHash, pShift + BITS, pKey, pValue ) );
+
+			// Empty slot
+			node_lp->mEntries.insert( node_lp->mEntries.begin( ) + index( node_lp->mEntriesMap, bit_ ), entry_t( pKey, pValue ) );
+			node_lp->mEntriesMap |= bit_;
+			return( true );
+
+		}
+
+		/* Removes existing entry */
+		static void remove( node_ptr & pNode, const std::size_t pHash, const unsigned int pShift, const K & pKey )
+		{
+
+			// Node
+			persistent_map_node *const node_lp( edit( pNode ) );
+
+			// Collision node
+			if ( pShift >= HASH_BITS )
+			{
+				for ( std::size_t i = 0; i < node_lp->mEntries.size( ); i++ )
+				{
+					if ( E( )( node_lp->mEntries[i].first, pKey ) )
+					{
+						node_lp->mEntries.erase( node_lp->mEntries.begin( ) + i );
+						return;
+					}
+				}
+				return;
+			}
+
+			// Slot
+			const std::uint32_t bit_( slot( pHash, pShift ) );
+
+			// Entry in the slot
+			if ( ( node_lp->mEntriesMap & bit_ ) != 0 )
+			{
+				node_lp->mEntries.erase( node_lp->mEntries.begin( ) + index( node_lp->mEntriesMap, bit_ ) );
+				node_lp->mEntriesMap &= ~bit_;
+				return;
+			}
+
+			// Child
+			const std::size_t childIndex_( index( node_lp->mChildrenMap, bit_ ) );
+			node_ptr & child_lr( node_lp->mChildren[childIndex_] );
+			remove( child_lr, pHash, pShift + BITS, pKey );
+
+			// Child with single entry, move entry to this node
+			const persistent_map_node & childNode_lr( child_lr.getRef( ) );
+			if ( childNode_lr.mChildren.empty( ) && childNode_lr.mEntries.size( ) == 1 )
+			{
+				node_lp->mEntries.insert( node_lp->mEntries.begin( ) + index( node_lp->mEntriesMap, bit_ ), childNode_lr.mEntries[0] );
+				node_lp->mEntriesMap |= bit_;
+			}
+
+			// Remove child, which entries were moved
+			if ( childNode_lr.mChildren.empty( ) && childNode_lr.mEntries.size( ) < 2 )
+			{
+				node_lp->mChildren.erase( node_lp->mChildren.begin( ) + childIndex_ );
+				node_lp->mChildrenMap &= ~bit_;
+			}
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructor
+		// ===========================================================
+
+		/* persistent_map default constructor, empty */
+		persistent_map( ) noexcept
+			: mRoot( ),
+			mSize( 0 )
+		{
+		}
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/* Returns number of entries */
+		const std::size_t size( ) const noexcept
+		{ return( mSize ); }
+
+		/* Returns true if there are no entries */
+		const bool empty( ) const noexcept
+		{ return( mSize == 0 ); }
+
+		/*
+		 * Searches value.
+		 *
+		 * @param pKey - key.
+		 * @return - value, or null.
+		*/
+		const V *const find( const K & pKey ) const
+		{
+
+			// Search
+			const std::size_t hash_( H( )( pKey ) );
+			const persistent_map_node * node_lp( mRoot.getPtr( ) );
+			for ( unsigned int shift_ = 0; node_lp != nullptr; shift_ += BITS )
+			{
+
+				// Collision node
+				if ( shift_ >= HASH_BITS )
+				{
+					for ( const entry_t & entry_lr : node_lp->mEntries )
+					{
+						if ( E( )( entry_lr.first, pKey ) )
+							return( &entry_lr.second );
+					}
+					return( nullptr );
+				}
+
+				// Slot
+				const std::uint32_t bit_( slot( hash_, shift_ ) );
+
+				// Entry
+				if ( ( node_lp->mEntriesMap & bit_ ) != 0 )
+				{
+					const entry_t & entry_lr( node_lp->mEntries[index( node_lp->mEntriesMap, bit_ )] );
+					return( E( )( entry_lr.first, pKey ) ? &entry_lr.second : nullptr );
+				}
+
+				// Child
+				node_lp = ( node_lp->mChildrenMap & bit_ ) != 0 ? node_lp->mChildren[index( node_lp->mChildrenMap, bit_ )].getPtr( ) : nullptr;
+
+			}
+
+			// Return result
+			return( nullptr );
+
+		}
+
+		/*
+		 * Inserts or replaces value.
+		 *
+		 * @param pKey - key.
+		 * @param pValue - value.
+		 * @return - true if inserted, false if replaced.
+		 * @throws - std::bad_alloc, or K & V copy exception.
+		*/
+		const bool set( const K & pKey, const V & pValue )
+		{
+
+			// Insert
+			const bool result_( put( mRoot, H( )( pKey ), 0, pKey, pValue ) );
+			if ( result_ )
+				mSize++;
+
+			// Return result
+			return( result_ );
+
+		}
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Removes value.
+		 *
+		 * @param pKey - key.
+		 * @return - false if not found.
+		 * @throws - std::bad_alloc, or K & V copy exception.
+		*/
+		const bool erase( const K & pKey )
+		{
+
+			// Not found, nodes are not copied
+			if ( find( pKey ) == nullptr )
+				return( false );
+
+			// Remove
+			remove( mRoot, H( )( pKey ), 0, pKey );
+			mSize--;
+
+			// Empty
+			if ( mSize == 0 )
+				mRoot.reset( );
+
+			// Return OK
+			return( true );
+
+		}
+
+		/* Removes all entries */
+		void clear( ) noexcept
+		{
+
+			mRoot.reset( );
+			mSize = 0;
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	/* persistent_map stores only root fast_ptr & size, can be moved with memcpy */
+	template <typename K, typename V, typename H, typename E>
+	struct is_trivially_relocatable<persistent_map<K, V, H, E>> : public std::true_type
+	{
+	};
+
+	// ===========================================================
+	// Fields
+	// ===========================================================
+
+	/* Definition of the constants (C++ 11) */
+	template <typename K, typename V, typename H, typename E>
+	constexpr unsigned int persistent_map<K, V, H, E>::BITS;
+
+	template <typename K, typename V, typename H, typename E>
+	constexpr std::size_t persistent_map<K, V, H, E>::MASK;
+
+	template <typename K, typename V, typename H, typename E>
+	constexpr unsigned int persistent_map<K, V, H, E>::HASH_BITS;
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_PERSISTENT_MAP_HXX_
@@ -0,0 +1,348 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_PERSISTENT_VECTOR_HXX_
+#define _C0DE4UN_PERSISTENT_VECTOR_HXX_
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::vector
+#include <vector>
+
+// Include fast_ptr
+#include "fast_ptr.hxx"
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_PERSISTENT_VECTOR_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * persistent_vector - vector with structural sharing (32-way trie).
+	 *
+	 * Copy is a snapshot: O(1), shares all nodes through fast_ptr counters.
+	 * Update copies only nodes on the path to the root, which are shared with
+	 * other snapshots, uniquely owned nodes are modified in place.
+	 * Access & updates are O(log32 n).
+	 *
+	 * (!) Node can be shared by up to 65535 snapshots (fast_ptr counter).
+	 * (!) Same instance is not thread-safe, different snapshots are (with
+	 * _C0DE4UN_MULTITHREADING_ENABLED_).
+	 *
+	 * @version 0.1.0
+	*/
+	template <typename T>
+	class persistent_vector final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constants
+		// ===========================================================
+
+		/* Index bits per level */
+		static constexpr unsigned int BITS = 5;
+
+		/* Children per node */
+		static constexpr std::size_t WIDTH = 1 << BITS;
+
+		/* Index mask per level */
+		static constexpr std::size_t MASK = WIDTH - 1;
+
+		// ===========================================================
+		// Types
+		// ===========================================================
+
+		/* Trie node. Leafs store values, other nodes store children. */
+		struct persistent_vector_node
+		{
+
+			/* Children, for internal node */
+			std::vector<fast_ptr<persistent_vector_node>> mChildren;
+
+			/* Values, for leaf */
+			std::vector<T> mValues;
+
+		};
+
+		/* Type-Alias for node pointer */
+		using node_ptr = fast_ptr<persistent_vector_node>;
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Root node */
+		node_ptr mRoot;
+
+		/* Number of values */
+		std::size_t mSize;
+
+		/* Index shift of the root level, 0 if root is leaf */
+		unsigned int mShift;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Returns node for modification, copies it, if shared.
+		 *
+		 * (?) Called from the root, so shared parent is copied before children,
+		 * which become shared by the copy.
+		 *
+		 * @throws - std::bad_alloc, or T copy exception.
+		*/
+		static persistent_vector_node *const edit( node_ptr & pNode )
+		{
+
+			// Create
+			if ( pNode == nullptr )
+				pNode = node_ptr( new persistent_vector_node( ) );
+			else if ( pNode.count( ) > 1 ) // Copy shared
+				pNode = node_ptr( new persistent_vector_node( pNode.getRef( ) ) );
+
+			// Return result
+			return( pNode.getPtr( ) );
+
+		}
+
+		/* Appends value at the given level */
+		static void push( node_ptr & pNode, const unsigned int pShift, const std::size_t pIndex, const T & pValue )
+		{
+
+			// Node
+			persistent_vector_node *const node_lp( edit( pNode ) );
+
+			// Leaf
+			if ( pShift == 0 )
+			{
+				node_lp->mValues.push_back( pValue );
+				return;
+			}
+
+			// Child
+			const std::size_t slot_( ( pIndex >> pShift ) & MASK );
+			if ( slot_ == node_lp->mChildren.size( ) )
+				node_lp->mChildren.push_back( node_ptr( ) );
+			push( node_lp->mChildren[slot_], pShift - BITS, pIndex, pValue );
+
+		}
+
+		/* Removes last value at the given level. Returns true if node became empty. */
+		static const bool pop( node_ptr & pNode, const unsigned int pShift, const std::size_t pIndex )
+		{
+
+			// Node
+			persistent_vector_node *const node_lp( edit( pNode ) );
+
+			// Leaf
+			if ( pShift == 0 )
+			{
+				node_lp->mValues.pop_back( );
+				return( node_lp->mValues.empty( ) );
+			}
+
+			// Child
+			const std::size_t slot_( ( pIndex >> pShift ) & MASK );
+			if ( pop( node_lp->mChildren[slot_], pShift - BITS, pIndex ) )
+				node_lp->mChildren.pop_back( );
+
+			// Return result
+			return( node_lp->mChildren.empty( ) );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructor
+		// ===========================================================
+
+		/* persistent_vector default constructor, empty */
+		persistent_vector( ) noexcept
+			: mRoot( ),
+			mSize( 0 ),
+			mShift( 0 )
+		{
+		}
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/* Returns number of values */
+		const std::size_t size( ) const noexcept
+		{ return( mSize ); }
+
+		/* Returns true if there are no values */
+		const bool empty( ) const noexcept
+		{ return( mSize == 0 ); }
+
+		/*
+		 * Returns value.
+		 *
+		 * (!) Index must be less than #size.
+		 *
+		 * @param pIndex - index.
+		*/
+		const T & get( const std::size_t pIndex ) const noexcept
+		{
+
+			// Search leaf
+			const persistent_vector_node * node_lp( mRoot.getPtr( ) );
+			for ( unsigned int shift_ = mShift; shift_ > 0; shift_ -= BITS )
+				node_lp = node_lp->mChildren[( pIndex >> shift_ ) & MASK].getPtr( );
+
+			// Return result
+			return( node_lp->mValues[pIndex & MASK] );
+
+		}
+
+		/* Returns value. (!) Index must be less than #size. */
+		const T & operator[]( const std::size_t pIndex ) const noexcept
+		{ return( get( pIndex ) ); }
+
+		/*
+		 * Replaces value.
+		 *
+		 * (!) Index must be less than #size.
+		 *
+		 * @param pIndex - index.
+		 * @param pValue - value.
+		 * @throws - std::bad_alloc, or T copy exception.
+		*/
+		void set( const std::size_t pIndex, const T & pValue )
+		{
+
+			// Search leaf, copy shared nodes
+			node_ptr * node_lp( &mRoot );
+			for ( unsigned int shift_ = mShift; shift_ > 0; shift_ -= BITS )
+				node_lp = &edit( *node_lp )->mChildren[( pIndex >> shift_ ) & MASK];
+
+			// Set
+			edit( *node_lp )->mValues[pIndex & MASK] = pValue;
+
+		}
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Appends value.
+		 *
+		 * @param pValue - value.
+		 * @throws - std::bad_alloc, or T copy exception.
+		*/
+		void push_back( const T & pValue )
+		{
+
+			// Root is full, add level
+			if ( mRoot != nullptr && mSize == ( static_cast<std::size_t>( 1 ) << ( mShift + BITS ) ) )
+			{
+				node_ptr root_( new persistent_vector_node( ) );
+				root_.getRef( ).mChildren.push_back( mRoot );
+				mRoot = root_;
+				mShift += BITS;
+			}
+
+			// Append
+			push( mRoot, mShift, mSize, pValue );
+			mSize++;
+
+		}
+
+		/*
+		 * Removes last value.
+		 *
+		 * (!) Vector must not be empty.
+		 *
+		 * @throws - std::bad_alloc, or T copy exception.
+		*/
+		void pop_back( )
+		{
+
+			// Remove
+			pop( mRoot, mShift, mSize - 1 );
+			mSize--;
+
+			// Empty
+			if ( mSize == 0 )
+			{
+				mRoot.reset( );
+				mShift = 0;
+				return;
+			}
+
+			// Remove level
+			if ( mShift > 0 && mRoot.getRef( ).mChildren.size( ) == 1 )
+			{
+				node_ptr child_( mRoot.getRef( ).mChildren[0] );
+				mRoot = child_;
+				mShift -= BITS;
+			}
+
+		}
+
+		/* Removes all values */
+		void clear( ) noexcept
+		{
+
+			mRoot.reset( );
+			mSize = 0;
+			mShift = 0;
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	/* persistent_vector stores only root fast_ptr & sizes, can be moved with memcpy */
+	template <typename T>
+	struct is_trivially_relocatable<persistent_vector<T>> : public std::true_type
+	{
+	};
+
+	// ===========================================================
+	// Fields
+	// ===========================================================
+
+	/* Definition of the constants (C++ 11) */
+	template <typename T>
+	constexpr unsigned int persistent_vector<T>::BITS;
+
+	template <typename T>
+	constexpr std::size_t persistent_vector<T>::WIDTH;
+
+	template <typename T>
+	constexpr std::size_t persistent_vector<T>::MASK;
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_PERSISTENT_VECTOR_HXX_
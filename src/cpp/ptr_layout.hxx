@@ -0,0 +1,176 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_PTR_LAYOUT_HXX_
+#define _C0DE4UN_PTR_LAYOUT_HXX_
+
+// Include std::size_t
+#include <cstddef>
+
+// Include std::atomic
+#include <atomic>
+
+// Default layout of the shared data (PACKED, ALIGNED, CACHE_LINE)
+#ifndef _C0DE4UN_POINTERS_LAYOUT_
+#define _C0DE4UN_POINTERS_LAYOUT_ ALIGNED
+#endif // !_C0DE4UN_POINTERS_LAYOUT_
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_PTR_LAYOUT_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Constants
+	// ===========================================================
+
+	/* Cache-line size (bytes), used by ptr_layout::CACHE_LINE */
+	constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+	/*
+	 * Counter value of the immortal rel_ptr (trel_ptr) data: copies & destructors
+	 * don't change the counter, object is never deleted.
+	*/
+	constexpr unsigned int REL_PTR_IMMORTAL = 0xFFFFFFFF;
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * ptr_layout - memory layout of the data, shared between pointers.
+	*/
+	enum class ptr_layout : unsigned char
+	{
+		PACKED, // 1-byte alignment: smallest, counter can cross cache-line (split lock)
+		ALIGNED, // Natural alignment: counter can share cache-line with neighbours
+		CACHE_LINE // Own cache-line: no false sharing, for hot (contended) objects
+	};
+
+	/*
+	 * ptr_layout_traits - layout selection per object type.
+	 *
+	 * (?) Uses _C0DE4UN_POINTERS_LAYOUT_ by default, specialize for specific types:
+	 * template <> struct ptr_layout_traits<Hot> { static constexpr ptr_layout LAYOUT = ptr_layout::CACHE_LINE; };
+	*/
+	template <typename T>
+	struct ptr_layout_traits
+	{
+
+		/* Layout */
+		static constexpr ptr_layout LAYOUT = ptr_layout::_C0DE4UN_POINTERS_LAYOUT_;
+
+	};
+
+	/*
+	 * rel_ptr_fields - counter & object, stored in the registry, with the given layout.
+	 *
+	 * (!) CACHE_LINE requires over-aligned new (C++ 17) for heap & map nodes.
+	*/
+	template <typename T, ptr_layout L>
+	struct rel_ptr_fields;
+
+// Enable structure-data (fields, variables) alignment (by compilator) to 1 byte
+#pragma pack( push, 1 )
+
+	/* Packed counter & object */
+	template <typename T>
+	struct rel_ptr_fields<T, ptr_layout::PACKED>
+	{
+
+		/* Instances counters */
+		std::atomic<unsigned int> mCounter;
+
+		/* Stored Object Instance */
+		T * mObject;
+
+		/* rel_ptr_fields default constructor */
+		rel_ptr_fields( ) noexcept
+			: mCounter( 0 ),
+			mObject( nullptr )
+		{
+		}
+
+	};
+
+// Restore structure-data alignment to default (8-byte on MSVC)
+#pragma pack( pop )
+
+	/* Naturally aligned counter & object */
+	template <typename T>
+	struct rel_ptr_fields<T, ptr_layout::ALIGNED>
+	{
+
+		/* Instances counters */
+		std::atomic<unsigned int> mCounter;
+
+		/* Stored Object Instance */
+		T * mObject;
+
+		/* rel_ptr_fields default constructor */
+		rel_ptr_fields( ) noexcept
+			: mCounter( 0 ),
+			mObject( nullptr )
+		{
+		}
+
+	};
+
+	/* Counter & object on own cache-line */
+	template <typename T>
+	struct alignas( CACHE_LINE_SIZE ) rel_ptr_fields<T, ptr_layout::CACHE_LINE>
+	{
+
+		/* Instances counters */
+		std::atomic<unsigned int> mCounter;
+
+		/* Stored Object Instance */
+		T * mObject;
+
+		/* rel_ptr_fields default constructor */
+		rel_ptr_fields( ) noexcept
+			: mCounter( 0 ),
+			mObject( nullptr )
+		{
+		}
+
+	};
+
+	// ===========================================================
+	// Methods
+	// ===========================================================
+
+	/*
+	 * Returns true, if counter of the data (rel_ptr_fields) is REL_PTR_IMMORTAL.
+	 *
+	 * (?) Immortal counter is never changed, so relaxed load is enough.
+	 *
+	 * @param pData - data, can be null.
+	*/
+	template <typename D>
+	inline const bool is_immortal( const D *const pData ) noexcept
+	{ return( pData != nullptr && pData->mCounter.load( std::memory_order_relaxed ) == REL_PTR_IMMORTAL ); }
+
+	// ===========================================================
+	// Fields
+	// ===========================================================
+
+	/* Definition of the constants (C++ 11) */
+	template <typename T>
+	constexpr ptr_layout ptr_layout_traits<T>::LAYOUT;
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_PTR_LAYOUT_HXX_
@@ -0,0 +1,177 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_PTR_REGISTRY_HXX_
+#define _C0DE4UN_PTR_REGISTRY_HXX_
+
+// Include std::atomic
+#include <atomic>
+
+// Include std::mutex, std::lock_guard
+#include <mutex>
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_PTR_REGISTRY_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * ptr_registry - single, process-wide, instance of the pointers registry (cache).
+	 *
+	 * Instance is created on first use (or by #initialize) & destroyed only by
+	 * #shutdown, never by static destruction, so pointers can be released from
+	 * other static objects destructors. Holder is defined in header only (inline
+	 * functions), but all translation units share the same instance.
+	 *
+	 * @thread_safety - thread-safe, atomic pointer & thread-lock on creation used.
+	 * @version 0.1.0
+	*/
+	template <typename C>
+	class ptr_registry final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/* Returns instance pointer. Constant-initialized, no static constructor. */
+		static std::atomic<C*> & instance( ) noexcept
+		{
+
+			// Instance
+			static std::atomic<C*> instance_( nullptr );
+
+			// Return result
+			return( instance_ );
+
+		}
+
+		/* Returns creation mutex */
+		static std::mutex & mutex( ) noexcept
+		{
+
+			// Mutex
+			static std::mutex mutex_;
+
+			// Return result
+			return( mutex_ );
+
+		}
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Creates instance, if it wasn't created by other thread.
+		 *
+		 * @throws - std::bad_alloc, mutex.
+		*/
+		static C *const create( )
+		{
+
+			// Lock
+			std::lock_guard<std::mutex> lock_( mutex( ) );
+
+			// Search
+			C * result_lp( instance( ).load( std::memory_order_acquire ) );
+
+			// Create
+			if ( result_lp == nullptr )
+			{
+				result_lp = new C( );
+				instance( ).store( result_lp, std::memory_order_release );
+			}
+
+			// Return result
+			return( result_lp );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/*
+		 * Returns registry, creates it on first call.
+		 *
+		 * @throws - std::bad_alloc, mutex.
+		*/
+		static C & get( )
+		{
+
+			// Search
+			C *const instance_lp( instance( ).load( std::memory_order_acquire ) );
+
+			// Return result
+			return( instance_lp != nullptr ? *instance_lp : *create( ) );
+
+		}
+
+		/* Returns true if registry is created */
+		static const bool isInitialized( ) noexcept
+		{ return( instance( ).load( std::memory_order_acquire ) != nullptr ); }
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Creates registry, if it's not created yet.
+		 *
+		 * @throws - std::bad_alloc, mutex.
+		*/
+		static void initialize( )
+		{ get( ); }
+
+		/*
+		 * Destroys registry. Next use creates new one.
+		 *
+		 * (!) Call only when all pointers are released & no other thread uses registry.
+		 *
+		 * @throws - mutex.
+		*/
+		static void shutdown( )
+		{
+
+			// Lock
+			std::lock_guard<std::mutex> lock_( mutex( ) );
+
+			// Destroy
+			delete instance( ).exchange( nullptr, std::memory_order_acq_rel );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_PTR_REGISTRY_HXX_
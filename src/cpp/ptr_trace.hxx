@@ -0,0 +1,342 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_PTR_TRACE_HXX_
+#define _C0DE4UN_PTR_TRACE_HXX_
+
+// Include std::uint8_t, std::uint32_t, std::uint64_t
+#include <cstdint>
+
+#ifdef _C0DE4UN_POINTERS_TRACE_ENABLED_ // Capture Mode
+
+// Include std::vector
+#include <vector>
+
+// Include std::unordered_map
+#include <unordered_map>
+
+// Include std::unique_ptr
+#include <memory>
+
+// Include std::mutex, std::lock_guard
+#include <mutex>
+
+// Include std::ostream
+#include <iostream>
+
+// Include ptr_registry
+#include "ptr_registry.hxx"
+
+/* Records pointer operation, see c0de4un::ptr_trace */
+#define _C0DE4UN_POINTERS_TRACE_( pOperation, pObject ) ::c0de4un::ptr_trace::record( ::c0de4un::trace_op::pOperation, pObject )
+
+#else
+
+/* Capture Mode disabled */
+#define _C0DE4UN_POINTERS_TRACE_( pOperation, pObject ) ( void )0
+
+#endif // _C0DE4UN_POINTERS_TRACE_ENABLED_
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_PTR_TRACE_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Constants
+	// ===========================================================
+
+	/* Trace file signature, "C0PT" */
+	constexpr std::uint32_t TRACE_MAGIC = 0x54503043;
+
+	/* Trace file format version */
+	constexpr std::uint32_t TRACE_VERSION = 1;
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * trace_op - traced pointer operation.
+	*/
+	enum class trace_op : std::uint8_t
+	{
+		CREATE, // New object, first reference
+		COPY, // New reference, copied from other pointer
+		LOOKUP, // New reference, found by object address (registry)
+		RELEASE, // Reference released
+		FREE // Object deleted, address can be reused. Not replayed.
+	};
+
+	/*
+	 * trace_record - single traced operation.
+	*/
+	struct trace_record final
+	{
+
+		/* Global order of the operation */
+		std::uint64_t mSequence;
+
+		/* Object ID, starts from 1 */
+		std::uint32_t mObject;
+
+		/* Operation */
+		trace_op mOperation;
+
+	};
+
+#ifdef _C0DE4UN_POINTERS_TRACE_ENABLED_
+
+	/*
+	 * trace_thread - operations of single thread.
+	*/
+	struct trace_thread final
+	{
+
+		/* Operations, in order */
+		std::vector<trace_record> mRecords;
+
+	};
+
+	/*
+	 * ptr_trace - records pointers operations (Capture Mode), for replay by benchmark.
+	 *
+	 * Enabled by _C0DE4UN_POINTERS_TRACE_ENABLED_, then fast_ptr, rel_ptr & trel_ptr
+	 * record every create, copy, lookup & release. Each thread appends to own
+	 * buffer. Objects are identified by IDs, not addresses, & all operations have
+	 * global sequence number, so original interleaving can be restored.
+	 *
+	 * (?) Recording is thread-locked, use for capture only.
+	 *
+	 * @thread_safety - #record is thread-safe, #save & #clear require stopped workload.
+	 * @version 0.1.0
+	*/
+	class ptr_trace final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Thread-lock */
+		std::mutex mMutex;
+
+		/* Next sequence number */
+		std::uint64_t mSequence;
+
+		/* Next object ID */
+		std::uint32_t mNextObject;
+
+		/* IDs of alive objects, by address */
+		std::unordered_map<const void*, std::uint32_t> mObjects;
+
+		/* Threads buffers */
+		std::vector<std::unique_ptr<trace_thread>> mThreads;
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/* Returns buffer of the current thread, registered by recorder */
+		static trace_thread *& threadBuffer( ) noexcept
+		{
+
+			// Buffer
+			static thread_local trace_thread * buffer_( nullptr );
+
+			// Return result
+			return( buffer_ );
+
+		}
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Records operation of the current thread.
+		 *
+		 * @param pOperation - operation.
+		 * @param pObject - object address.
+		 * @throws - std::bad_alloc, mutex.
+		*/
+		static void recordOperation( const trace_op pOperation, const void *const pObject )
+		{
+
+			// Recorder
+			ptr_trace & trace_lr( ptr_registry<ptr_trace>::get( ) );
+
+			// Lock
+			std::lock_guard<std::mutex> lock_( trace_lr.mMutex );
+
+			// Register thread
+			trace_thread *& buffer_lr( threadBuffer( ) );
+			if ( buffer_lr == nullptr )
+			{
+				trace_lr.mThreads.emplace_back( new trace_thread( ) );
+				buffer_lr = trace_lr.mThreads.back( ).get( );
+			}
+
+			// Address can be reused by other object
+			if ( pOperation == trace_op::FREE )
+			{
+				trace_lr.mObjects.erase( pObject );
+				return;
+			}
+
+			// Object ID. (?) Objects, created before recording, get ID on first use.
+			std::uint32_t & id_lr( trace_lr.mObjects[pObject] );
+			if ( id_lr == 0 || pOperation == trace_op::CREATE )
+				id_lr = trace_lr.mNextObject++;
+
+			// Record
+			buffer_lr->mRecords.push_back( trace_record{ trace_lr.mSequence++, id_lr, pOperation } );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructor
+		// ===========================================================
+
+		/* ptr_trace default constructor */
+		ptr_trace( )
+			: mMutex( ),
+			mSequence( 0 ),
+			mNextObject( 1 ),
+			mObjects( ),
+			mThreads( )
+		{
+		}
+
+		// ===========================================================
+		// Deleted
+		// ===========================================================
+
+		/* @deleted ptr_trace const copy constructor */
+		ptr_trace( const ptr_trace & ) = delete;
+
+		/* @deleted ptr_trace const copy assignment operator */
+		ptr_trace & operator=( const ptr_trace & ) = delete;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Records operation of the current thread.
+		 *
+		 * (!) Called by pointers, before counter update.
+		 * (?) Operation is lost, if there is no memory to record it.
+		 *
+		 * @param pOperation - operation.
+		 * @param pObject - object address, ignored if null.
+		*/
+		static void record( const trace_op pOperation, const void *const pObject ) noexcept
+		{
+
+			// Cancel
+			if ( pObject == nullptr )
+				return;
+
+			try
+			{
+				recordOperation( pOperation, pObject );
+			}
+			catch ( ... )
+			{
+			}
+
+		}
+
+		/*
+		 * Writes recorded operations.
+		 *
+		 * Format (host byte order): TRACE_MAGIC, TRACE_VERSION, threads count (u32),
+		 * then per thread: records count (u32) & records (sequence u64, object u32, operation u8).
+		 *
+		 * @param pOutput - output stream.
+		*/
+		static void save( std::ostream & pOutput )
+		{
+
+			// Recorder
+			ptr_trace & trace_lr( ptr_registry<ptr_trace>::get( ) );
+
+			// Lock
+			std::lock_guard<std::mutex> lock_( trace_lr.mMutex );
+
+			// Header
+			const std::uint32_t magic_( TRACE_MAGIC );
+			const std::uint32_t version_( TRACE_VERSION );
+			const std::uint32_t threads_( static_cast<std::uint32_t>( trace_lr.mThreads.size( ) ) );
+			pOutput.write( reinterpret_cast<const char*>( &magic_ ), sizeof( magic_ ) );
+			pOutput.write( reinterpret_cast<const char*>( &version_ ), sizeof( version_ ) );
+			pOutput.write( reinterpret_cast<const char*>( &threads_ ), sizeof( threads_ ) );
+
+			// Threads
+			for ( const std::unique_ptr<trace_thread> & thread_lr : trace_lr.mThreads )
+			{
+
+				// Count
+				const std::uint32_t count_( static_cast<std::uint32_t>( thread_lr->mRecords.size( ) ) );
+				pOutput.write( reinterpret_cast<const char*>( &count_ ), sizeof( count_ ) );
+
+				// Records
+				for ( const trace_record & record_lr : thread_lr->mRecords )
+				{
+					pOutput.write( reinterpret_cast<const char*>( &record_lr.mSequence ), sizeof( record_lr.mSequence ) );
+					pOutput.write( reinterpret_cast<const char*>( &record_lr.mObject ), sizeof( record_lr.mObject ) );
+					pOutput.write( reinterpret_cast<const char*>( &record_lr.mOperation ), sizeof( record_lr.mOperation ) );
+				}
+
+			}
+
+		}
+
+		/* Removes recorded operations. Alive objects keep IDs. */
+		static void clear( )
+		{
+
+			// Recorder
+			ptr_trace & trace_lr( ptr_registry<ptr_trace>::get( ) );
+
+			// Lock
+			std::lock_guard<std::mutex> lock_( trace_lr.mMutex );
+
+			// Clear
+			for ( const std::unique_ptr<trace_thread> & thread_lr : trace_lr.mThreads )
+				thread_lr->mRecords.clear( );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+
+#endif // _C0DE4UN_POINTERS_TRACE_ENABLED_
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_PTR_TRACE_HXX_
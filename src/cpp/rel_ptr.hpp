@@ -42,12 +42,47 @@
 // Include STL map
 #include <map> // std::map
 
+// Include STL vector
+#include <vector> // std::vector
+
 // Include iostream
 #include <iostream> // std::cout, std::cin:: std::endl
 
 // Include stdlib
 #include <cstdlib>
 
+// Include std::nullptr_t
+#include <cstddef>
+
+// Include std::aligned_storage
+#include <type_traits>
+
+// Include std::forward
+#include <utility>
+
+// Include placement new
+#include <new>
+
+// Include rel_ptr_fields, ptr_layout_traits
+#include "ptr_layout.hxx"
+
+// Include ptr_registry
+#include "ptr_registry.hxx"
+
+// Include is_trivially_relocatable
+#include "relocatable.hxx"
+
+// Include _C0DE4UN_POINTERS_TRACE_
+#include "ptr_trace.hxx"
+
+// Include _C0DE4UN_POINTERS_BORROW_CHECK_
+#include "borrow_tracker.hxx"
+
+// Map node handles (C++ 17) allows to key entry by the object, constructed inside it
+#if __cplusplus >= 201703L || ( defined( _MSVC_LANG ) && _MSVC_LANG >= 201703L )
+#define _C0DE4UN_POINTERS_NODE_HANDLE_
+#endif // C++ 17
+
 namespace c0de4un
 {
 
@@ -57,14 +92,14 @@ namespace c0de4un
 	// Types
 	// ===========================================================
 
-// Enable structure-data (fields, variables) alignment (by compilator) to 1 byte
-#pragma pack( push, 1 )
-
 	/*
 	 * rel_ptr_data - structure to store shared between 'smart-pointers' data.
+	 *
+	 * (?) Fields (mCounter, mObject) layout is selected by ptr_layout_traits<T>.
+	 * (?) Object, constructed inside the entry, is stored by rel_ptr_emplaced_data.
 	*/
 	template <typename T>
-	struct rel_ptr_data final
+	struct rel_ptr_data : public rel_ptr_fields<T, ptr_layout_traits<T>::LAYOUT>
 	{
 
 		// -------------------------------------------------------- \\
@@ -73,11 +108,14 @@ namespace c0de4un
 		// Fields
 		// ===========================================================
 
-		/* Instances counters */
-		std::atomic<unsigned int> mCounter;
+		/* Newer retained entry (LRU list), see rel_ptr::retain */
+		rel_ptr_data<T> * mNewer;
 
-		/* Stored Object Instance */
-		T * mObject;
+		/* Older retained entry (LRU list), see rel_ptr::retain */
+		rel_ptr_data<T> * mOlder;
+
+		/* Size of the retained object, in bytes */
+		std::size_t mRetainedSize;
 
 		// ===========================================================
 		// Constructor & destructor
@@ -85,8 +123,10 @@ namespace c0de4un
 
 		/* rel_ptr_data default constructor */
 		rel_ptr_data( )
-			: mCounter( 0 ),
-			mObject( nullptr )
+			: rel_ptr_fields<T, ptr_layout_traits<T>::LAYOUT>( ),
+			mNewer( nullptr ),
+			mOlder( nullptr ),
+			mRetainedSize( 0 )
 		{
 
 			// Print Log
@@ -123,8 +163,185 @@ namespace c0de4un
 
 	};
 
+#ifdef _C0DE4UN_POINTERS_NODE_HANDLE_
+	/*
+	 * rel_ptr_emplaced_data - registry entry with the object, constructed inside
+	 * it, see rel_ptr::emplace. Stored separately from entries of objects,
+	 * allocated by new, so they don't pay for the storage.
+	*/
+	template <typename T>
+	struct rel_ptr_emplaced_data final : public rel_ptr_data<T>
+	{
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Storage for the object */
+		typename std::aligned_storage<sizeof( T ), alignof( T )>::type mStorage;
+
+		// ===========================================================
+		// Constructor & destructor
+		// ===========================================================
+
+		/* rel_ptr_emplaced_data default constructor */
+		rel_ptr_emplaced_data( )
+			: rel_ptr_data<T>( ),
+			mStorage( )
+		{
+		}
+
+		/* rel_ptr_emplaced_data destructor, destroys Object, if constructed */
+		~rel_ptr_emplaced_data( )
+		{
+
+			if ( this->mObject != nullptr )
+				this->mObject->~T( );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+#endif // _C0DE4UN_POINTERS_NODE_HANDLE_
+
+	/*
+	 * rel_ptr_retain_traits - size of the retained object, see rel_ptr::retain.
+	 *
+	 * (?) Object size by default, specialize to count owned memory.
+	*/
+	template <typename T>
+	struct rel_ptr_retain_traits
+	{
+
+		/* Returns size of the object, in bytes */
+		static const std::size_t size( const T & ) noexcept
+		{ return( sizeof( T ) ); }
+
+	};
+
+	/*
+	 * rel_ptr_garbage - objects & entries, removed from the cache with thread-lock.
+	 * Deleted after unlock, so object destructor can release rel_ptr of the same type.
+	 *
+	 * (?) Single object doesn't allocate, more are stored by evict.
+	*/
+	template <typename T>
+	struct rel_ptr_garbage final
+	{
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Types
+		// ===========================================================
+
+#ifdef _C0DE4UN_POINTERS_NODE_HANDLE_
+		/* Type-Alias for entry of the emplaced object */
+		using entry_t = typename std::map<T const*, rel_ptr_emplaced_data<T>>::node_type;
+#endif // _C0DE4UN_POINTERS_NODE_HANDLE_
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Object, allocated by new */
+		T * mObject;
+
+		/* Objects, allocated by new, if more than one */
+		std::vector<T*> mObjects;
+
+#ifdef _C0DE4UN_POINTERS_NODE_HANDLE_
+		/* Entry of the emplaced object, object is destroyed with entry */
+		entry_t mEntry;
+
+		/* Entries of the emplaced objects, if more than one */
+		std::vector<entry_t> mEntries;
+#endif // _C0DE4UN_POINTERS_NODE_HANDLE_
+
+		// ===========================================================
+		// Constructor & destructor
+		// ===========================================================
+
+		/* rel_ptr_garbage default constructor */
+		rel_ptr_garbage( ) noexcept
+			: mObject( nullptr ),
+			mObjects( )
+#ifdef _C0DE4UN_POINTERS_NODE_HANDLE_
+			, mEntry( ),
+			mEntries( )
+#endif // _C0DE4UN_POINTERS_NODE_HANDLE_
+		{
+		}
+
+		/* rel_ptr_garbage destructor, deletes Objects. Entries are destroyed with members. */
+		~rel_ptr_garbage( )
+		{
+
+			// Delete Objects
+			delete mObject;
+			for ( T *const object_lp : mObjects )
+				delete object_lp;
+
+		}
+
+		// ===========================================================
+		// Deleted
+		// ===========================================================
+
+		/* @deleted rel_ptr_garbage const copy constructor */
+		rel_ptr_garbage( const rel_ptr_garbage & ) = delete;
+
+		/* @deleted rel_ptr_garbage const copy assignment operator */
+		rel_ptr_garbage & operator=( const rel_ptr_garbage & ) = delete;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Adds Object, allocated by new.
+		 *
+		 * @throws - std::bad_alloc, for more than one object.
+		*/
+		void add( T *const pObject )
+		{
+
+			if ( mObject == nullptr )
+				mObject = pObject;
+			else
+				mObjects.push_back( pObject );
+
+		}
+
+#ifdef _C0DE4UN_POINTERS_NODE_HANDLE_
+		/*
+		 * Adds entry of the emplaced Object.
+		 *
+		 * @throws - std::bad_alloc, for more than one entry.
+		*/
+		void add( entry_t && pEntry )
+		{
+
+			if ( mEntry.empty( ) )
+				mEntry = std::move( pEntry );
+			else
+				mEntries.push_back( std::move( pEntry ) );
+
+		}
+#endif // _C0DE4UN_POINTERS_NODE_HANDLE_
+
+		// -------------------------------------------------------- \\
+
+	};
+
 	/*
 	 * rel_ptr_cache - stores rel_ptr_data instances (cache, pool).
+	 *
+	 * (?) In retain mode, entries without instances are kept in LRU list,
+	 * see rel_ptr::retain.
 	*/
 	template <typename T>
 	struct rel_ptr_cache final
@@ -139,11 +356,31 @@ namespace c0de4un
 		/* Pointers instances */
 		std::map<T const*, rel_ptr_data<T>> mPointersData;
 
-		/* Mutex */
+#ifdef _C0DE4UN_POINTERS_NODE_HANDLE_
+		/* Pointers instances of the emplaced objects, see rel_ptr::emplace */
+		std::map<T const*, rel_ptr_emplaced_data<T>> mEmplacedData;
+#endif // _C0DE4UN_POINTERS_NODE_HANDLE_
+
+		/* Mutex, guards entries, counters of the entries & LRU list */
 		std::mutex mMutex;
 
-		/* unique_lock */
-		std::unique_lock<std::mutex> mLock;
+		/* Most recently released retained entry */
+		rel_ptr_data<T> * mNewest;
+
+		/* Least recently released retained entry, evicted first */
+		rel_ptr_data<T> * mOldest;
+
+		/* Number of retained entries */
+		std::size_t mRetainedCount;
+
+		/* Size of retained objects, in bytes */
+		std::size_t mRetainedBytes;
+
+		/* Max number of retained entries, 0 for no limit */
+		std::size_t mMaxRetainedCount;
+
+		/* Max size of retained objects, 0 for no limit */
+		std::size_t mMaxRetainedBytes;
 
 		// ===========================================================
 		// Constructor & destructor
@@ -152,8 +389,16 @@ namespace c0de4un
 		/* rel_ptr_cache default constructor */
 		rel_ptr_cache( )
 			: mPointersData( ),
+#ifdef _C0DE4UN_POINTERS_NODE_HANDLE_
+			mEmplacedData( ),
+#endif // _C0DE4UN_POINTERS_NODE_HANDLE_
 			mMutex( ),
-			mLock( mMutex, std::defer_lock )
+			mNewest( nullptr ),
+			mOldest( nullptr ),
+			mRetainedCount( 0 ),
+			mRetainedBytes( 0 ),
+			mMaxRetainedCount( 0 ),
+			mMaxRetainedBytes( 0 )
 		{
 
 			// Print Log
@@ -168,6 +413,86 @@ namespace c0de4un
 			// Print Log
 			std::cout << "rel_ptr_cache::destructor" << std::endl;
 
+			// Delete retained Objects, emplaced are destroyed with Data
+			for ( rel_ptr_data<T> * data_lp = mNewest; data_lp != nullptr; data_lp = data_lp->mOlder )
+			{
+				if ( isEmplaced( data_lp->mObject ) )
+					continue;
+				delete data_lp->mObject;
+			}
+
+		}
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/* Returns true, if object is constructed inside the entry, see rel_ptr::emplace */
+		const bool isEmplaced( const T *const pObject ) const
+		{
+#ifdef _C0DE4UN_POINTERS_NODE_HANDLE_
+			return( !mEmplacedData.empty( ) && mEmplacedData.count( pObject ) > 0 );
+#else
+			return( false );
+#endif // _C0DE4UN_POINTERS_NODE_HANDLE_
+		}
+
+		/* Returns entry, or null if object is not registered */
+		rel_ptr_data<T> *const findData( const T *const pObject )
+		{
+
+#ifdef _C0DE4UN_POINTERS_NODE_HANDLE_
+			// Emplaced
+			if ( !mEmplacedData.empty( ) )
+			{
+				typename std::map<T const*, rel_ptr_emplaced_data<T>>::iterator emplacedPos = mEmplacedData.find( pObject );
+				if ( emplacedPos != mEmplacedData.end( ) )
+					return( &emplacedPos->second );
+			}
+#endif // _C0DE4UN_POINTERS_NODE_HANDLE_
+
+			// Allocated by new
+			typename std::map<T const*, rel_ptr_data<T>>::iterator dataPos = mPointersData.find( pObject );
+			return( dataPos != mPointersData.end( ) ? &dataPos->second : nullptr );
+
+		}
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Removes entry. Object is deleted with garbage, after unlock, emplaced
+		 * Object is destroyed with entry.
+		 *
+		 * @param pObject - object.
+		 * @param pGarbage - deleted objects.
+		 * @throws - std::bad_alloc, see rel_ptr_garbage#add.
+		*/
+		void eraseData( T *const pObject, rel_ptr_garbage<T> & pGarbage )
+		{
+
+			// Trace
+			_C0DE4UN_POINTERS_TRACE_( FREE, pObject );
+			_C0DE4UN_POINTERS_BORROW_CHECK_( pObject );
+
+#ifdef _C0DE4UN_POINTERS_NODE_HANDLE_
+			// Emplaced
+			if ( !mEmplacedData.empty( ) )
+			{
+				typename std::map<T const*, rel_ptr_emplaced_data<T>>::iterator emplacedPos = mEmplacedData.find( pObject );
+				if ( emplacedPos != mEmplacedData.end( ) )
+				{
+					pGarbage.add( mEmplacedData.extract( emplacedPos ) );
+					return;
+				}
+			}
+#endif // _C0DE4UN_POINTERS_NODE_HANDLE_
+
+			// Allocated by new
+			pGarbage.add( pObject );
+			mPointersData.erase( pObject );
+
 		}
 
 		// ===========================================================
@@ -190,9 +515,6 @@ namespace c0de4un
 
 	};
 
-// Restore structure-data alignment to default (8-byte on MSVC)
-#pragma pack( pop )
-
 	// ===========================================================
 	// Fields
 	// ===========================================================
@@ -203,9 +525,6 @@ namespace c0de4un
 	// Types
 	// ===========================================================
 
-// Enable structure-data (fields, variables) alignment (by compilator) to 1 byte
-#pragma pack( push, 1 )
-
 	/*
 	 * rel_ptr - custom 'relative-pointer', as an alternative to the STL 'shared_ptr'.
 	 * 
@@ -225,9 +544,6 @@ namespace c0de4un
 		// Fields
 		// ===========================================================
 
-		/* Cache */
-		static rel_ptr_cache<T> mCache;
-
 		/* Data */
 		rel_ptr_data<T> * mData;
 
@@ -235,6 +551,15 @@ namespace c0de4un
 		// Getter & Setter
 		// ===========================================================
 
+		/*
+		 * Returns process-wide cache for the type, creates it on first call.
+		 *
+		 * @thread_safety - thread-safe.
+		 * @throws - std::bad_alloc, mutex.
+		*/
+		static rel_ptr_cache<T> & getCache( )
+		{ return( ptr_registry<rel_ptr_cache<T>>::get( ) ); }
+
 		/*
 		 * Allocate or search 'rel_ptr' data.
 		 * 
@@ -251,21 +576,40 @@ namespace c0de4un
 			if ( pObject == nullptr )
 				return( nullptr );
 
+			// Cache
+			rel_ptr_cache<T> & cache_lr( getCache( ) );
+
 			// Lock
-			mCache.mLock.lock( );
+			cache_lr.mMutex.lock( );
 
-			// Data
-			rel_ptr_data<T> *const result_lr = &mCache.mPointersData[pObject];
+			// Data, new entry if not found
+			rel_ptr_data<T> * result_lr( cache_lr.findData( pObject ) );
+			if ( result_lr == nullptr )
+				result_lr = &cache_lr.mPointersData[pObject];
 
 			// 
 			if ( result_lr->mObject == nullptr )
+			{
+				_C0DE4UN_POINTERS_TRACE_( CREATE, pObject );
 				result_lr->mObject = pObject;
+			}
+			else
+			{
 
-			// Increase instances counter
-			result_lr->mCounter++;
+				_C0DE4UN_POINTERS_TRACE_( LOOKUP, pObject );
+
+				// Revive retained
+				if ( isRetained( cache_lr, result_lr ) )
+					unlinkRetained( cache_lr, result_lr );
+
+			}
+
+			// Increase instances counter, if object is not immortal
+			if ( !is_immortal( result_lr ) )
+				result_lr->mCounter++;
 
 			// Unlock
-			mCache.mLock.unlock( );
+			cache_lr.mMutex.unlock( );
 
 			// Return result
 			return( result_lr );
@@ -276,8 +620,83 @@ namespace c0de4un
 		// Methods
 		// ===========================================================
 
+		/* Returns true if entries without instances are retained */
+		static const bool isRetaining( const rel_ptr_cache<T> & pCache ) noexcept
+		{ return( pCache.mMaxRetainedCount > 0 || pCache.mMaxRetainedBytes > 0 ); }
+
+		/*
+		 * Returns true if entry is linked to the LRU list. Called with thread-lock.
+		 *
+		 * (?) Counter is not checked: only linked entry can be revived & unlinked.
+		*/
+		static const bool isRetained( const rel_ptr_cache<T> & pCache, const rel_ptr_data<T> *const pData ) noexcept
+		{ return( pData->mNewer != nullptr || pData->mOlder != nullptr || pCache.mNewest == pData ); }
+
 		/*
-		 * Removes 'rel_ptr' data & delete Object.
+		 * Removes entry from the LRU list. Called with thread-lock.
+		 *
+		 * @param pCache - cache.
+		 * @param pData - retained entry.
+		*/
+		static void unlinkRetained( rel_ptr_cache<T> & pCache, rel_ptr_data<T> *const pData ) noexcept
+		{
+
+			// Unlink
+			if ( pData->mNewer != nullptr )
+				pData->mNewer->mOlder = pData->mOlder;
+			else
+				pCache.mNewest = pData->mOlder;
+
+			if ( pData->mOlder != nullptr )
+				pData->mOlder->mNewer = pData->mNewer;
+			else
+				pCache.mOldest = pData->mNewer;
+
+			pData->mNewer = nullptr;
+			pData->mOlder = nullptr;
+
+			// Update size
+			pCache.mRetainedCount--;
+			pCache.mRetainedBytes -= pData->mRetainedSize;
+
+		}
+
+		/*
+		 * Deletes least recently released entries, until limits are satisfied.
+		 * Deletes all, if retain mode is disabled. Called with thread-lock.
+		 *
+		 * @param pCache - cache.
+		 * @param pGarbage - deleted objects.
+		*/
+		static void evict( rel_ptr_cache<T> & pCache, rel_ptr_garbage<T> & pGarbage )
+		{
+
+			while ( pCache.mOldest != nullptr )
+			{
+
+				// Limits
+				if ( isRetaining( pCache )
+					&& ( pCache.mMaxRetainedCount < 1 || pCache.mRetainedCount <= pCache.mMaxRetainedCount )
+					&& ( pCache.mMaxRetainedBytes < 1 || pCache.mRetainedBytes <= pCache.mMaxRetainedBytes ) )
+					return;
+
+				// Oldest entry
+				rel_ptr_data<T> *const data_lp( pCache.mOldest );
+				unlinkRetained( pCache, data_lp );
+
+				// Remove Data & Object
+				pCache.eraseData( data_lp->mObject, pGarbage );
+
+			}
+
+		}
+
+		/*
+		 * Decreases instances counter. Removes 'rel_ptr' data & delete Object,
+		 * or retains it, when last instance is released.
+		 *
+		 * (?) Counter is tested & decreased with thread-lock, so concurrent
+		 * releases of the last instances can't skip removal or retain.
 		 * 
 		 * @thread_Safety - thread-lock used.
 		*/
@@ -291,25 +710,121 @@ namespace c0de4un
 			if ( pObject == nullptr )
 				return;
 
+			// Cache
+			rel_ptr_cache<T> & cache_lr( getCache( ) );
+
+			// Objects, deleted after unlock
+			rel_ptr_garbage<T> garbage_;
+
 			// Lock
-			mCache.mLock.lock( );
+			cache_lr.mMutex.lock( );
 
 			// Search
-			std::map<T const*, rel_ptr_data<T>>::const_iterator dataIterator_ = mCache.mPointersData.find( pObject );
+			rel_ptr_data<T> *const data_lp( cache_lr.findData( pObject ) );
 
-			if ( dataIterator_ != mCache.mPointersData.cend( ) )
+			if ( data_lp != nullptr )
 			{
 
-				// Remove Data
-				mCache.mPointersData.erase( pObject );
+				// Data
+				rel_ptr_data<T> & data_lr( *data_lp );
+
+				// Other instances left
+				if ( data_lr.mCounter > 1 )
+					data_lr.mCounter--;
+				else if ( isRetaining( cache_lr ) )
+				{
+
+					// Retain, as newest
+					data_lr.mCounter = 0;
+					data_lr.mRetainedSize = rel_ptr_retain_traits<T>::size( *pObject );
+					data_lr.mOlder = cache_lr.mNewest;
+					data_lr.mNewer = nullptr;
+					if ( cache_lr.mNewest != nullptr )
+						cache_lr.mNewest->mNewer = &data_lr;
+					else
+						cache_lr.mOldest = &data_lr;
+					cache_lr.mNewest = &data_lr;
+					cache_lr.mRetainedCount++;
+					cache_lr.mRetainedBytes += data_lr.mRetainedSize;
+
+					// Evict over limits
+					evict( cache_lr, garbage_ );
+
+				}
+				else // Remove Data & Object
+					cache_lr.eraseData( pObject, garbage_ );
+
+			}
 
-				// Delete Object
-				delete pObject;
+			// Unlock, Objects are deleted with garbage
+			cache_lr.mMutex.unlock( );
+
+		}
+
+		/*
+		 * Releases Data, 'pointer' becomes null.
+		 *
+		 * @thread_safety - thread-lock used.
+		*/
+		void release( )
+		{
+
+			// Manage Data, immortal data is not changed
+			if ( mData != nullptr && !is_immortal( mData ) )
+			{
+
+				// Trace
+				_C0DE4UN_POINTERS_TRACE_( RELEASE, mData->mObject );
+
+				// Decrease instances counter, Remove Data & Release Object, if last
+				removeData( mData->mObject );
 
 			}
 
-			// Unlock
-			mCache.mLock.unlock( );
+			// Reset
+			mData = nullptr;
+
+		}
+
+		/*
+		 * Adds instance of the registered object, if object has instances & isn't
+		 * immortal. Called with thread-lock, see #instances.
+		 *
+		 * (!) Capacity must be reserved.
+		*/
+		static void addInstance( std::vector<rel_ptr<T>> & pInstances, rel_ptr_data<T> & pData )
+		{
+
+			// Retained or immortal
+			if ( pData.mCounter < 1 || is_immortal( &pData ) )
+				return;
+
+			// Increase instances counter
+			pData.mCounter++;
+			pInstances.emplace_back( nullptr );
+			pInstances.back( ).mData = &pData;
+
+		}
+
+		/*
+		 * Returns Data to share with new instance.
+		 *
+		 * @thread_safety - thread-lock used, if object is not immortal.
+		 * @param pData - data, can be null.
+		*/
+		static rel_ptr_data<T> *const copyData( rel_ptr_data<T> *const pData )
+		{
+
+			// Cancel
+			if ( pData == nullptr )
+				return( nullptr );
+
+			// Immortal data is shared without thread-lock
+			if ( is_immortal( pData ) )
+				return( pData );
+
+			// Increase instances counter
+			return( getData( pData->mObject ) );
 
 		}
 
@@ -349,7 +864,8 @@ namespace c0de4un
 			// Print Log
 			std::cout << "rel_ptr::copy-constructor" << std::endl;
 
-			mData = getData( pOther.mData->mObject );
+			// Set Data
+			mData = copyData( pOther.mData );
 
 		}
 
@@ -380,17 +896,8 @@ namespace c0de4un
 			// Print Log
 			std::cout << "rel_ptr::destructor" << std::endl;
 
-			// Manage Data
-			if ( mData != nullptr )
-			{
-
-				// Decrease instances counter
-				if ( mData->mCounter > 1 )
-					mData->mCounter--;
-				else // Remove Data & Release Object
-					removeData( mData->mObject );
-
-			}
+			// Release Data
+			release( );
 
 		}
 
@@ -402,6 +909,222 @@ namespace c0de4un
 		// Methods & Operators
 		// ===========================================================
 
+		/*
+		 * Creates process-wide cache for the type, if it's not created yet.
+		 * Optional, cache is created on first use.
+		 *
+		 * @throws - std::bad_alloc, mutex.
+		*/
+		static void initialize( )
+		{ ptr_registry<rel_ptr_cache<T>>::initialize( ); }
+
+		/*
+		 * Destroys process-wide cache for the type. Cache is never destroyed by
+		 * static destruction.
+		 *
+		 * (!) Call only when all rel_ptr<T> instances are released.
+		 *
+		 * @throws - mutex.
+		*/
+		static void shutdown( )
+		{ ptr_registry<rel_ptr_cache<T>>::shutdown( ); }
+
+		/*
+		 * Sets retain mode: objects without instances are not deleted, but kept in
+		 * the cache (LRU), until limits are exceeded, & returned by #find, or
+		 * rel_ptr constructor, without construction. Least recently released objects
+		 * are deleted first. Retained objects are deleted by #shutdown.
+		 *
+		 * (?) Object size is returned by rel_ptr_retain_traits.
+		 * (?) Both limits 0 disable retain mode & delete retained objects.
+		 *
+		 * @thread_safety - thread-lock used.
+		 * @param pCount - max number of retained objects, 0 for no limit.
+		 * @param pBytes - max size of retained objects, 0 for no limit.
+		 * @throws - std::bad_alloc, mutex.
+		*/
+		static void retain( const std::size_t pCount, const std::size_t pBytes )
+		{
+
+			// Cache
+			rel_ptr_cache<T> & cache_lr( getCache( ) );
+
+			// Objects, deleted after unlock
+			rel_ptr_garbage<T> garbage_;
+
+			// Lock
+			cache_lr.mMutex.lock( );
+
+			// Set limits & evict
+			cache_lr.mMaxRetainedCount = pCount;
+			cache_lr.mMaxRetainedBytes = pBytes;
+			evict( cache_lr, garbage_ );
+
+			// Unlock, Objects are deleted with garbage
+			cache_lr.mMutex.unlock( );
+
+		}
+
+		/*
+		 * Searches object in the cache, including retained (see #retain).
+		 *
+		 * (?) Unlike rel_ptr constructor, unknown address is not registered, so
+		 * address of the evicted object can be used as a key.
+		 * (!) Address of the evicted object can be reused by new object.
+		 *
+		 * @thread_safety - thread-lock used.
+		 * @param pObject - object address.
+		 * @return - rel_ptr, null if object is not found.
+		 * @throws - std::bad_alloc, mutex.
+		*/
+		static rel_ptr<T> find( const T *const pObject )
+		{
+
+			// Result
+			rel_ptr<T> result_( nullptr );
+
+			// Cache
+			rel_ptr_cache<T> & cache_lr( getCache( ) );
+
+			// Lock
+			cache_lr.mMutex.lock( );
+
+			// Search
+			rel_ptr_data<T> *const data_lp( cache_lr.findData( pObject ) );
+			if ( data_lp != nullptr )
+			{
+
+				// Trace
+				_C0DE4UN_POINTERS_TRACE_( LOOKUP, data_lp->mObject );
+
+				// Revive retained
+				if ( isRetained( cache_lr, data_lp ) )
+					unlinkRetained( cache_lr, data_lp );
+
+				// Increase instances counter, if object is not immortal
+				if ( !is_immortal( data_lp ) )
+					data_lp->mCounter++;
+				result_.mData = data_lp;
+
+			}
+
+			// Unlock
+			cache_lr.mMutex.unlock( );
+
+			// Return result
+			return( result_ );
+
+		}
+
+		/*
+		 * Returns instances of all registered objects, which have instances.
+		 * Retained (see #retain) & immortal objects are skipped.
+		 *
+		 * (?) Allows to use registry as the set of roots, see cycle_collector.
+		 *
+		 * @thread_safety - thread-lock used.
+		 * @return - rel_ptr for each object.
+		 * @throws - std::bad_alloc, mutex.
+		*/
+		static std::vector<rel_ptr<T>> instances( )
+		{
+
+			// Result
+			std::vector<rel_ptr<T>> result_;
+
+			// Cache
+			rel_ptr_cache<T> & cache_lr( getCache( ) );
+
+			// Lock
+			cache_lr.mMutex.lock( );
+
+			// Allocate
+			try
+			{
+#ifdef _C0DE4UN_POINTERS_NODE_HANDLE_
+				result_.reserve( cache_lr.mPointersData.size( ) + cache_lr.mEmplacedData.size( ) );
+#else
+				result_.reserve( cache_lr.mPointersData.size( ) );
+#endif // _C0DE4UN_POINTERS_NODE_HANDLE_
+			}
+			catch ( ... )
+			{
+				cache_lr.mMutex.unlock( );
+				throw;
+			}
+
+			// Add instances
+			for ( std::pair<T const *const, rel_ptr_data<T>> & data_lr : cache_lr.mPointersData )
+				addInstance( result_, data_lr.second );
+#ifdef _C0DE4UN_POINTERS_NODE_HANDLE_
+			for ( std::pair<T const *const, rel_ptr_emplaced_data<T>> & data_lr : cache_lr.mEmplacedData )
+				addInstance( result_, data_lr.second );
+#endif // _C0DE4UN_POINTERS_NODE_HANDLE_
+
+			// Unlock
+			cache_lr.mMutex.unlock( );
+
+			// Return result
+			return( result_ );
+
+		}
+
+		/*
+		 * Constructs object inside the registry entry, keyed by the object address,
+		 * so creation & access use single allocation. Raw-pointer lookup works as usual.
+		 *
+		 * (?) Requires C++ 17 node handles, otherwise object is allocated separately.
+		 *
+		 * @thread_safety - thread-lock used.
+		 * @param pArgs - object constructor arguments.
+		 * @return - rel_ptr.
+		 * @throws - std::bad_alloc, mutex, or object constructor exception.
+		*/
+		template <typename... Args>
+		static rel_ptr<T> emplace( Args&&... pArgs )
+		{
+
+			// Print Log
+			std::cout << "rel_ptr::emplace" << std::endl;
+
+			// Result
+			rel_ptr<T> result_( nullptr );
+
+#ifdef _C0DE4UN_POINTERS_NODE_HANDLE_
+			// Allocate entry, not linked to the cache
+			std::map<T const*, rel_ptr_emplaced_data<T>> entries_;
+			entries_.try_emplace( nullptr );
+			typename std::map<T const*, rel_ptr_emplaced_data<T>>::node_type entry_( entries_.extract( entries_.begin( ) ) );
+
+			// Construct Object, without thread-lock. Entry is deallocated, if exception thrown.
+			rel_ptr_emplaced_data<T> & data_lr( entry_.mapped( ) );
+			T *const object_lp( new( &data_lr.mStorage ) T( std::forward<Args>( pArgs )... ) );
+			data_lr.mObject = object_lp;
+			data_lr.mCounter++;
+			entry_.key( ) = object_lp;
+			_C0DE4UN_POINTERS_TRACE_( CREATE, object_lp );
+
+			// Cache
+			rel_ptr_cache<T> & cache_lr( getCache( ) );
+
+			// Lock
+			cache_lr.mMutex.lock( );
+
+			// Link entry. Key is unique, object address is used by this entry only.
+			result_.mData = &cache_lr.mEmplacedData.insert( std::move( entry_ ) ).position->second;
+
+			// Unlock
+			cache_lr.mMutex.unlock( );
+#else
+			// Object & entry are allocated separately
+			result_.mData = getData( new T( std::forward<Args>( pArgs )... ) );
+#endif // _C0DE4UN_POINTERS_NODE_HANDLE_
+
+			// Return result
+			return( result_ );
+
+		}
+
 		/* rel_ptr copy assignment operator */
 		rel_ptr & operator=( rel_ptr & pOther )
 		{
@@ -413,8 +1136,15 @@ namespace c0de4un
 			if ( pOther == *this )
 				return( *this );
 
+			// Copy Data, then release previous
+			rel_ptr_data<T> *const data_lp( copyData( pOther.mData ) );
+			release( );
+
 			// Set Data
-			mData = getData( pOther.mData->mObject );
+			mData = data_lp;
+
+			// Return
+			return( *this );
 
 		}
 
@@ -426,32 +1156,38 @@ namespace c0de4un
 			std::cout << "rel_ptr::move-assignment operator" << std::endl;
 
 			// Cancel
-			if ( pOther == *this )
+			if ( this == &pOther )
 				return( *this );
 
+			// Release previous Data
+			release( );
+
 			// Set Data
 			mData = pOther.mData;
 
 			// Reset
 			pOther.mData = nullptr;
 
+			// Return
+			return( *this );
+
 		}
 
 		T & getRef( )
 		{ return( *mData->mObject ); }
 
-		T *const get( )
+		T *const get( ) const noexcept
 		{ return( mData != nullptr ? mData->mObject : nullptr ); }
 
 		T *const operator*( )
 		{ return( mData != nullptr ? mData->mObject : nullptr ); }
 
 		/* Returns true if 'pointer' is nullptr */
-		const bool operator==( nullptr_t ) const noexcept
+		const bool operator==( std::nullptr_t ) const noexcept
 		{ return( mData == nullptr || mData->mObject == nullptr ); }
 
 		/* Returns true if 'pointer' is not nullptr */
-		const bool operator!=( nullptr_t ) const noexcept
+		const bool operator!=( std::nullptr_t ) const noexcept
 		{ return( mData != nullptr || mData->mObject != nullptr ); }
 
 		/* Pointer address access operator */
@@ -466,6 +1202,40 @@ namespace c0de4un
 		const bool operator==( T *const pObject ) const noexcept
 		{ return( mData != nullptr ? pObject == mData->mObject : pObject == nullptr ); }
 
+		/*
+		 * Makes object immortal: copies & destructors don't change the counter &
+		 * don't use thread-lock. Object, allocated by new, is never deleted, even
+		 * by #shutdown.
+		 *
+		 * (!) Call before object is shared between threads.
+		 * (!) Emplaced object (see #emplace) is destroyed with its entry by
+		 * #shutdown, don't use immortal instances after it.
+		 * (?) Does nothing, if 'pointer' is null.
+		 *
+		 * @thread_safety - thread-lock used.
+		 * @throws - std::bad_alloc, mutex.
+		*/
+		void makeImmortal( )
+		{
+
+			// Cancel
+			if ( mData == nullptr )
+				return;
+
+			// Cache
+			rel_ptr_cache<T> & cache_lr( getCache( ) );
+
+			// Set counter
+			cache_lr.mMutex.lock( );
+			mData->mCounter = REL_PTR_IMMORTAL;
+			cache_lr.mMutex.unlock( );
+
+		}
+
+		/* Returns true, if object is immortal, see #makeImmortal */
+		const bool isImmortal( ) const noexcept
+		{ return( is_immortal( mData ) ); }
+
 		/* Returns instances counter */
 		const unsigned int count( )
 		{
@@ -485,16 +1255,15 @@ namespace c0de4un
 
 	};
 
-// Restore structure-data alignment to default (8-byte on MSVC)
-#pragma pack( pop )
-
 	// ===========================================================
-	// Fields
+	// Types
 	// ===========================================================
 
-	/* Initialize variable value */
+	/* rel_ptr stores only address of the registry data, can be moved with memcpy */
 	template <typename T>
-	rel_ptr_cache<T> rel_ptr<T>::mCache;
+	struct is_trivially_relocatable<rel_ptr<T>> : public std::true_type
+	{
+	};
 
 	// -------------------------------------------------------- \\
 
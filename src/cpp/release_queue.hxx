@@ -0,0 +1,479 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_RELEASE_QUEUE_HXX_
+#define _C0DE4UN_RELEASE_QUEUE_HXX_
+
+#ifdef _C0DE4UN_POINTERS_ITERATIVE_RELEASE_ENABLED_ // Iterative Release Mode
+
+// Include std::size_t
+#include <cstddef>
+
+// Include std::malloc, std::free
+#include <cstdlib>
+
+// Include std::memcpy
+#include <cstring>
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_ // Multithreading Mode
+
+// Include std::atomic
+#include <atomic>
+
+// Include std::thread
+#include <thread>
+
+// Include std::mutex, std::lock_guard
+#include <mutex>
+
+// Include std::vector
+#include <vector>
+
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_RELEASE_QUEUE_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Forward-Declarations
+	// ===========================================================
+
+	struct fast_ptr_block;
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * release_item - object, which last instance released, not deleted yet.
+	*/
+	struct release_item
+	{
+
+		/* Type-Alias for delete function: ( object, block ) */
+		using delete_t = void ( * )( void *const, fast_ptr_block *const );
+
+		/* Object */
+		void * mObject;
+
+		/* Control block */
+		fast_ptr_block * mBlock;
+
+		/* Deletes object & block */
+		delete_t mDelete;
+
+	};
+
+	/*
+	 * release_queue - converts cascading releases into a loop.
+	 *
+	 * First final release on the thread deletes object & then deletes objects,
+	 * released by its destructor (& so on) one by one, from the thread-local
+	 * worklist. So stack usage doesn't depend on the depth of the graph, which
+	 * is released.
+	 *
+	 * (?) Worklist is LIFO (depth-first), long chains use single item.
+	 * (?) Without memory for the worklist, object is deleted recursively.
+	 * (?) With _C0DE4UN_MULTITHREADING_ENABLED_ worklist can be split between
+	 * worker threads, see parallel_release_scope.
+	 *
+	 * @version 0.1.0
+	*/
+	class release_queue final
+	{
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Friends
+		// ===========================================================
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+		/* Splits worklist */
+		friend class parallel_release_scope;
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+		// -------------------------------------------------------- \\
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constants
+		// ===========================================================
+
+		/* Worklist items without allocation */
+		static constexpr std::size_t LOCAL_CAPACITY = 64;
+
+		// ===========================================================
+		// Types
+		// ===========================================================
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+		/* Worker threads of the parallel_release_scope */
+		struct release_workers
+		{
+
+			/* Number of threads, which still can be started */
+			std::atomic<unsigned int> mAvailable;
+
+			/* Worklist size, to split */
+			std::size_t mThreshold;
+
+			/* Threads lock */
+			std::mutex mMutex;
+
+			/* Started threads */
+			std::vector<std::thread> mThreads;
+
+		};
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+		/*
+		 * Thread worklist.
+		 *
+		 * (?) Trivial, so thread-local instance has no constructor & destructor,
+		 * & can be used during threads & program exit.
+		*/
+		struct release_state
+		{
+
+			/* Items, before allocation */
+			release_item mLocal[LOCAL_CAPACITY];
+
+			/* Allocated items, null if #mLocal is used */
+			release_item * mItems;
+
+			/* Allocated items capacity */
+			std::size_t mCapacity;
+
+			/* Number of items */
+			std::size_t mSize;
+
+			/* true while worklist is processed */
+			bool mDraining;
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+			/* Workers of the active parallel_release_scope, or null */
+			release_workers * mWorkers;
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+		};
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Returns worklist of the current thread */
+		static release_state & getState( ) noexcept
+		{
+
+			// Thread-local, zero-initialized
+			static thread_local release_state state_;
+
+			// Return result
+			return( state_ );
+
+		}
+
+		/* Returns items of the worklist */
+		static release_item *const getItems( release_state & pState ) noexcept
+		{ return( pState.mItems != nullptr ? pState.mItems : pState.mLocal ); }
+
+		/* Adds item. Returns false, if there is no memory. */
+		static const bool push( release_state & pState, const release_item & pItem ) noexcept
+		{
+
+			// Grow
+			std::size_t capacity_( LOCAL_CAPACITY );
+			if ( pState.mItems != nullptr )
+				capacity_ = pState.mCapacity;
+			if ( pState.mSize == capacity_ )
+			{
+
+				// Allocate
+				release_item *const items_lp( static_cast<release_item*>( std::malloc( capacity_ * 2 * sizeof( release_item ) ) ) );
+				if ( items_lp == nullptr )
+					return( false );
+
+				// Move items
+				std::memcpy( items_lp, getItems( pState ), pState.mSize * sizeof( release_item ) );
+				if ( pState.mItems != nullptr )
+					std::free( pState.mItems );
+				pState.mItems = items_lp;
+				pState.mCapacity = capacity_ * 2;
+
+			}
+
+			// Add
+			getItems( pState )[pState.mSize++] = pItem;
+
+			// Return OK
+			return( true );
+
+		}
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+		/* Processes items on the worker thread */
+		static void work( release_workers *const pWorkers, const std::vector<release_item> pItems ) noexcept
+		{
+
+			// Worklist
+			release_state & state_lr( getState( ) );
+			state_lr.mWorkers = pWorkers;
+			state_lr.mDraining = true;
+
+			// Delete
+			for ( const release_item & item_lr : pItems )
+			{
+				item_lr.mDelete( item_lr.mObject, item_lr.mBlock );
+				drain( state_lr );
+			}
+
+			// Reset
+			state_lr.mDraining = false;
+			state_lr.mWorkers = nullptr;
+
+		}
+
+		/* Moves half of the worklist to the new worker thread */
+		static void split( release_state & pState ) noexcept
+		{
+
+			// Reserve thread
+			release_workers *const workers_lp( pState.mWorkers );
+			unsigned int available_( workers_lp->mAvailable.load( ) );
+			do
+			{
+				// No more threads, don't try again
+				if ( available_ < 1 )
+				{
+					pState.mWorkers = nullptr;
+					return;
+				}
+			}
+			while ( !workers_lp->mAvailable.compare_exchange_weak( available_, available_ - 1 ) );
+
+			// Start thread with the oldest items (upper levels of the graph)
+			const std::size_t count_( pState.mSize / 2 );
+			release_item *const items_lp( getItems( pState ) );
+			try
+			{
+				std::vector<release_item> items_( items_lp, items_lp + count_ );
+				std::lock_guard<std::mutex> lock_( workers_lp->mMutex );
+				workers_lp->mThreads.reserve( workers_lp->mThreads.size( ) + 1 );
+				workers_lp->mThreads.push_back( std::thread( &release_queue::work, workers_lp, std::move( items_ ) ) );
+			}
+			catch ( ... )
+			{
+				// Continue on this thread
+				workers_lp->mAvailable++;
+				pState.mWorkers = nullptr;
+				return;
+			}
+
+			// Remove moved items
+			std::memmove( items_lp, items_lp + count_, ( pState.mSize - count_ ) * sizeof( release_item ) );
+			pState.mSize -= count_;
+
+		}
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+		/* Deletes items, until worklist is empty. Frees allocated memory. */
+		static void drain( release_state & pState ) noexcept
+		{
+
+			// Delete
+			while ( pState.mSize > 0 )
+			{
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+				// Split
+				if ( pState.mWorkers != nullptr && pState.mSize >= pState.mWorkers->mThreshold )
+					split( pState );
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+				// Next item. Its destructor can add new items.
+				const release_item item_( getItems( pState )[--pState.mSize] );
+				item_.mDelete( item_.mObject, item_.mBlock );
+
+			}
+
+			// Free memory
+			if ( pState.mItems != nullptr )
+			{
+				std::free( pState.mItems );
+				pState.mItems = nullptr;
+				pState.mCapacity = 0;
+			}
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/*
+		 * Deletes object, which last instance released.
+		 *
+		 * (?) If called from the destructor of other released object, adds
+		 * object to the worklist & returns.
+		 *
+		 * @param pObject - object.
+		 * @param pBlock - control block.
+		 * @param pDelete - deletes object & block.
+		 * @thread_safety - thread-local.
+		*/
+		static void release( void *const pObject, fast_ptr_block *const pBlock, const release_item::delete_t pDelete ) noexcept
+		{
+
+			// Worklist
+			release_state & state_lr( getState( ) );
+
+			// Defer
+			if ( state_lr.mDraining )
+			{
+				const release_item item_{ pObject, pBlock, pDelete };
+				if ( !push( state_lr, item_ ) )
+					pDelete( pObject, pBlock );
+				return;
+			}
+
+			// Delete, then deferred objects
+			state_lr.mDraining = true;
+			pDelete( pObject, pBlock );
+			drain( state_lr );
+			state_lr.mDraining = false;
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+	/*
+	 * parallel_release_scope - splits large worklists between worker threads.
+	 *
+	 * While scope is alive, final releases on this thread move half of the
+	 * worklist to a new thread, when worklist size reaches threshold (wide
+	 * graphs). Destructor waits for all workers.
+	 *
+	 * (!) Objects destructors must be thread-safe: objects of the released
+	 * graph are deleted by different threads, in any order.
+	 *
+	 * @version 0.1.0
+	*/
+	class parallel_release_scope final
+	{
+
+		// -------------------------------------------------------- \\
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Workers */
+		release_queue::release_workers mWorkers;
+
+		/* Workers of the outer scope */
+		release_queue::release_workers * mPrevious;
+
+		// ===========================================================
+		// Deleted
+		// ===========================================================
+
+		/* @deleted parallel_release_scope const copy constructor */
+		parallel_release_scope( const parallel_release_scope & ) = delete;
+
+		/* @deleted parallel_release_scope const copy assignment operator */
+		parallel_release_scope & operator=( const parallel_release_scope & ) = delete;
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructor & destructor
+		// ===========================================================
+
+		/*
+		 * parallel_release_scope constructor
+		 *
+		 * @param pThreads - max number of worker threads.
+		 * @param pThreshold - worklist size, to split.
+		*/
+		explicit parallel_release_scope( const unsigned int pThreads = std::thread::hardware_concurrency( ), const std::size_t pThreshold = 4096 )
+			: mWorkers( ),
+			mPrevious( release_queue::getState( ).mWorkers )
+		{
+
+			mWorkers.mAvailable = pThreads;
+			mWorkers.mThreshold = pThreshold > 2 ? pThreshold : 2;
+			release_queue::getState( ).mWorkers = &mWorkers;
+
+		}
+
+		/* parallel_release_scope destructor, waits for workers */
+		~parallel_release_scope( ) noexcept
+		{
+
+			// Stop splitting
+			release_queue::getState( ).mWorkers = mPrevious;
+
+			// Wait. Workers can start other workers, before exit.
+			while ( true )
+			{
+
+				std::thread thread_;
+				{
+					std::lock_guard<std::mutex> lock_( mWorkers.mMutex );
+					if ( mWorkers.mThreads.empty( ) )
+						break;
+					thread_ = std::move( mWorkers.mThreads.back( ) );
+					mWorkers.mThreads.pop_back( );
+				}
+
+				thread_.join( );
+
+			}
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // _C0DE4UN_POINTERS_ITERATIVE_RELEASE_ENABLED_
+
+#endif // !_C0DE4UN_RELEASE_QUEUE_HXX_
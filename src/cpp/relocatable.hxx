@@ -0,0 +1,46 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_RELOCATABLE_HXX_
+#define _C0DE4UN_RELOCATABLE_HXX_
+
+// Include std::is_trivially_copyable
+#include <type_traits>
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_RELOCATABLE_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * is_trivially_relocatable - true if object can be moved to a new address with
+	 * memcpy, old copy is then abandoned without destructor call.
+	 *
+	 * (?) Trivially copyable types are relocatable. Specialize for types, which only
+	 * store pointers to other memory (not to itself), like fast_ptr.
+	*/
+	template <typename T>
+	struct is_trivially_relocatable
+		: public std::integral_constant<bool, std::is_trivially_copyable<T>::value>
+	{
+	};
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_RELOCATABLE_HXX_
@@ -0,0 +1,164 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_SHARED_PTR_INTEROP_HXX_
+#define _C0DE4UN_SHARED_PTR_INTEROP_HXX_
+
+// Include std::nullptr_t
+#include <cstddef>
+
+// Include std::shared_ptr, std::get_deleter
+#include <memory>
+
+// Include fast_ptr
+#include "fast_ptr.hxx"
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_SHARED_PTR_INTEROP_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * fast_ptr_deleter - std::shared_ptr deleter, which owns fast_ptr reference.
+	 *
+	 * (?) Reference is released, when last std::shared_ptr released, weak
+	 * pointers don't keep object alive.
+	*/
+	template <typename T>
+	struct fast_ptr_deleter final
+	{
+
+		/* Owned reference */
+		fast_ptr<T> mPointer;
+
+		/* Releases reference */
+		void operator()( T *const ) noexcept
+		{ mPointer.reset( ); }
+
+	};
+
+	/*
+	 * fast_ptr_shared_block - fast_ptr control block, which owns std::shared_ptr reference.
+	 *
+	 * (?) Reference is released with the block, when last fast_ptr released.
+	*/
+	template <typename T>
+	struct fast_ptr_shared_block final : public fast_ptr_block
+	{
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Owned reference */
+		std::shared_ptr<T> mShared;
+
+		// ===========================================================
+		// Constructor
+		// ===========================================================
+
+		/* fast_ptr_shared_block constructor */
+		explicit fast_ptr_shared_block( const std::shared_ptr<T> & pShared ) noexcept
+			: fast_ptr_block( &fast_ptr_shared_block<T>::release ),
+			mShared( pShared )
+		{
+		}
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Releases std::shared_ptr reference & deletes block */
+		static void release( fast_ptr_block *const pBlock, void *const )
+		{ delete static_cast<fast_ptr_shared_block<T>*>( pBlock ); }
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	// ===========================================================
+	// Methods
+	// ===========================================================
+
+	/*
+	 * Returns std::shared_ptr, which shares object with fast_ptr.
+	 *
+	 * (?) Object is deleted, when last fast_ptr & std::shared_ptr released.
+	 * std::shared_ptr control block (with deleter) is the single allocation.
+	 * For fast_ptr, adopted by #to_fast_ptr, original std::shared_ptr is returned,
+	 * without allocation.
+	 *
+	 * @param pPointer - fast_ptr.
+	 * @return - std::shared_ptr, empty if fast_ptr is null.
+	 * @throws - std::bad_alloc.
+	*/
+	template <typename T>
+	inline std::shared_ptr<T> to_shared_ptr( const fast_ptr<T> & pPointer )
+	{
+
+		// Null
+		if ( pPointer == nullptr )
+			return( std::shared_ptr<T>( ) );
+
+		// Adopted std::shared_ptr
+		fast_ptr_block *const block_lp( pPointer.getBlock( ) );
+		if ( block_lp->mRelease == &fast_ptr_shared_block<T>::release )
+			return( static_cast<fast_ptr_shared_block<T>*>( block_lp )->mShared );
+
+		// Share
+		const fast_ptr_deleter<T> deleter_{ pPointer };
+		return( std::shared_ptr<T>( pPointer.getPtr( ), deleter_ ) );
+
+	}
+
+	/*
+	 * Returns fast_ptr, which shares object with std::shared_ptr.
+	 *
+	 * (?) Object is deleted, when last fast_ptr & std::shared_ptr released.
+	 * fast_ptr control block (with std::shared_ptr) is the single allocation.
+	 * For std::shared_ptr, returned by #to_shared_ptr, original fast_ptr is
+	 * returned, without allocation.
+	 *
+	 * @param pShared - std::shared_ptr.
+	 * @return - fast_ptr, null if std::shared_ptr stores null.
+	 * @throws - std::bad_alloc.
+	*/
+	template <typename T>
+	inline fast_ptr<T> to_fast_ptr( const std::shared_ptr<T> & pShared )
+	{
+
+		// Null
+		if ( pShared == nullptr )
+			return( fast_ptr<T>( ) );
+
+		// Shared fast_ptr
+		const fast_ptr_deleter<T> *const deleter_lp( std::get_deleter<fast_ptr_deleter<T>>( pShared ) );
+		if ( deleter_lp != nullptr && deleter_lp->mPointer == pShared.get( ) )
+			return( deleter_lp->mPointer );
+
+		// Adopt
+		return( fast_ptr<T>( pShared.get( ), new fast_ptr_shared_block<T>( pShared ) ) );
+
+	}
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_SHARED_PTR_INTEROP_HXX_
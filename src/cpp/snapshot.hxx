@@ -0,0 +1,788 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_SNAPSHOT_HXX_
+#define _C0DE4UN_SNAPSHOT_HXX_
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::uint32_t, std::uint64_t
+#include <cstdint>
+
+// Include std::memcpy
+#include <cstring>
+
+// Include std::unique_ptr
+#include <memory>
+
+// Include std::ostream
+#include <ostream>
+
+// Include std::string
+#include <string>
+
+// Include std::map
+#include <map>
+
+// Include std::vector
+#include <vector>
+
+// Include std::runtime_error
+#include <stdexcept>
+
+// Include std::is_arithmetic, std::is_enum
+#include <type_traits>
+
+// Include fast_ptr
+#include "fast_ptr.hxx"
+
+// Include rel_ptr
+#include "rel_ptr.hpp"
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_SNAPSHOT_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Forward-Declarations
+	// ===========================================================
+
+	class snapshot_writer;
+	class snapshot_reader;
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * snapshot_traits - (de)serialization of objects, stored by fast_ptr or rel_ptr.
+	 *
+	 * (?) By default uses object methods:
+	 * - void save( snapshot_writer & ) const ;
+	 * - void load( snapshot_reader & ) ;
+	 * & default constructor. Specialize for types, which can't have them.
+	*/
+	template <typename T>
+	struct snapshot_traits
+	{
+
+		/* Creates empty object, before #load. (?) Object is registered before loading, so cycles are restored. */
+		static T *const create( )
+		{ return( new T( ) ); }
+
+		/* Writes object fields */
+		static void save( snapshot_writer & pWriter, const T & pObject )
+		{ pObject.save( pWriter ); }
+
+		/* Reads object fields */
+		static void load( snapshot_reader & pReader, T & pObject )
+		{ pObject.load( pReader ); }
+
+	};
+
+	/*
+	 * snapshot_writer - writes graph of fast_ptr & rel_ptr objects to a stream.
+	 *
+	 * Format (native byte order):
+	 * - header: magic (u32), version (u32), index offset (u64) ;
+	 * - pointer, written by object fields: id (u32), 0 for null ;
+	 * - pointer, written at top level: id (u32), size of records (u64) & records
+	 * of the objects, found from it ;
+	 * - record: id (u32), size (u64) & fields ;
+	 * - index, written by #finish: number of objects (u64), record offset (u64)
+	 * for each id.
+	 * Each object is written once, next pointers to it are back-references (id
+	 * only), so sharing & cycles are preserved. Records are not nested: objects,
+	 * found while writing the record, are queued, so deep graphs don't use stack.
+	 *
+	 * (?) Index allows reader to load only objects, reachable from the read
+	 * pointers, see snapshot_reader.
+	 * (!) Stream must be seekable (file, string-stream), sizes & index offset are patched.
+	 * (!) Not thread-safe, graph must not be changed while writing.
+	 *
+	 * @version 0.2.0
+	*/
+	class snapshot_writer final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Types
+		// ===========================================================
+
+		/* Queued object */
+		struct snapshot_record
+		{
+
+			/* Object */
+			const void * mObject;
+
+			/* Writes object fields */
+			void ( *mSave )( snapshot_writer & pWriter, const void *const pObject );
+
+			/* Id */
+			std::uint32_t mId;
+
+		};
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Output */
+		std::ostream & mStream;
+
+		/* Position of the header */
+		const std::streampos mStart;
+
+		/* Written objects ids */
+		std::map<const void*, std::uint32_t> mIds;
+
+		/* Record offsets, index = id - 1 */
+		std::vector<std::uint64_t> mOffsets;
+
+		/* Objects to write */
+		std::vector<snapshot_record> mRecords;
+
+		/* Number of records being written, 0 at top level */
+		std::size_t mDepth;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Writes raw bytes */
+		void writeBytes( const void *const pData, const std::size_t pSize )
+		{ mStream.write( static_cast<const char*>( pData ), static_cast<std::streamsize>( pSize ) ); }
+
+		/* Writes size placeholder, returns it's position */
+		const std::streampos reserveSize( )
+		{
+
+			// Position
+			const std::streampos result_( mStream.tellp( ) );
+			write( static_cast<std::uint64_t>( 0 ) );
+
+			// Return result
+			return( result_ );
+
+		}
+
+		/* Writes size of data, written after placeholder */
+		void patchSize( const std::streampos & pPosition )
+		{
+
+			// Size
+			const std::streampos endPos_( mStream.tellp( ) );
+			const std::uint64_t size_( static_cast<std::uint64_t>( endPos_ - pPosition ) - sizeof( std::uint64_t ) );
+
+			// Patch
+			mStream.seekp( pPosition );
+			write( size_ );
+			mStream.seekp( endPos_ );
+
+		}
+
+		/* Writes object fields */
+		template <typename T>
+		static void saveObject( snapshot_writer & pWriter, const void *const pObject )
+		{ snapshot_traits<T>::save( pWriter, *static_cast<const T*>( pObject ) ); }
+
+		/*
+		 * Writes pointer. New object is queued. At top level, queued objects
+		 * are written.
+		 *
+		 * @param pObject - object, can be null.
+		 * @throws - std::bad_alloc, stream exceptions, if enabled.
+		*/
+		template <typename T>
+		void writeObject( const T *const pObject )
+		{
+
+			// Id, 0 for null
+			std::uint32_t id_( 0 );
+			if ( pObject != nullptr )
+			{
+
+				// Search
+				std::map<const void*, std::uint32_t>::const_iterator idPos = mIds.find( pObject );
+
+				// Back-reference
+				if ( idPos != mIds.cend( ) )
+					id_ = idPos->second;
+				else
+				{
+
+					// New id, registered before fields, so cycles become back-references
+					id_ = static_cast<std::uint32_t>( mIds.size( ) + 1 );
+					mOffsets.push_back( 0 );
+					mRecords.push_back( snapshot_record{ pObject, &snapshot_writer::saveObject<T>, id_ } );
+					mIds[pObject] = id_;
+
+				}
+
+			}
+			write( id_ );
+
+			// Field, object is written after current record
+			if ( mDepth > 0 )
+				return;
+
+			// Records of the found objects
+			const std::streampos blockPos_( reserveSize( ) );
+			while ( !mRecords.empty( ) )
+			{
+
+				// Next
+				const snapshot_record record_( mRecords.back( ) );
+				mRecords.pop_back( );
+
+				// Header
+				mOffsets[record_.mId - 1] = static_cast<std::uint64_t>( mStream.tellp( ) - mStart );
+				write( record_.mId );
+				const std::streampos sizePos_( reserveSize( ) );
+
+				// Fields
+				mDepth++;
+				record_.mSave( *this, record_.mObject );
+				mDepth--;
+
+				// Size
+				patchSize( sizePos_ );
+
+			}
+			patchSize( blockPos_ );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constants
+		// ===========================================================
+
+		/* Format tag */
+		static constexpr std::uint32_t MAGIC = 0x31504E53; // "SNP1"
+
+		/* Format version */
+		static constexpr std::uint32_t VERSION = 2;
+
+		// ===========================================================
+		// Constructor
+		// ===========================================================
+
+		/*
+		 * snapshot_writer constructor, writes header.
+		 *
+		 * @param pStream - seekable output stream, opened in binary mode.
+		*/
+		explicit snapshot_writer( std::ostream & pStream )
+			: mStream( pStream ),
+			mStart( pStream.tellp( ) ),
+			mIds( ),
+			mOffsets( ),
+			mRecords( ),
+			mDepth( 0 )
+		{
+
+			// Header, index offset is patched by finish
+			const std::uint32_t magic_( MAGIC );
+			const std::uint32_t version_( VERSION );
+			write( magic_ );
+			write( version_ );
+			write( static_cast<std::uint64_t>( 0 ) );
+
+		}
+
+		// ===========================================================
+		// Deleted
+		// ===========================================================
+
+		/* @deleted snapshot_writer const copy constructor */
+		snapshot_writer( const snapshot_writer & ) = delete;
+
+		/* @deleted snapshot_writer const copy assignment operator */
+		snapshot_writer & operator=( const snapshot_writer & ) = delete;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Writes number or enum value */
+		template <typename T>
+		void write( const T & pValue )
+		{
+
+			// Only plain values
+			static_assert( std::is_arithmetic<T>::value || std::is_enum<T>::value, "snapshot_writer: use snapshot_traits for objects" );
+
+			// Write
+			writeBytes( &pValue, sizeof( T ) );
+
+		}
+
+		/* Writes string, size (u64) & characters */
+		void write( const std::string & pValue )
+		{
+
+			// Size
+			write( static_cast<std::uint64_t>( pValue.size( ) ) );
+
+			// Characters
+			writeBytes( pValue.data( ), pValue.size( ) );
+
+		}
+
+		/*
+		 * Writes pointer & object, if it wasn't written yet.
+		 *
+		 * @param pPointer - pointer to write, can be null.
+		 * @throws - std::bad_alloc, stream exceptions, if enabled.
+		*/
+		template <typename T>
+		void write( const fast_ptr<T> & pPointer )
+		{ writeObject<T>( pPointer.getPtr( ) ); }
+
+		/*
+		 * Writes pointer & object, if it wasn't written yet.
+		 *
+		 * @param pPointer - pointer to write, can be null.
+		 * @throws - std::bad_alloc, stream exceptions, if enabled.
+		*/
+		template <typename T>
+		void write( const rel_ptr<T> & pPointer )
+		{ writeObject<T>( pPointer.get( ) ); }
+
+		/*
+		 * Writes index of the records. Call once, after all values are written.
+		 *
+		 * @throws - stream exceptions, if enabled.
+		*/
+		void finish( )
+		{
+
+			// Index
+			const std::streampos indexPos_( mStream.tellp( ) );
+			write( static_cast<std::uint64_t>( mOffsets.size( ) ) );
+			for ( const std::uint64_t offset_ : mOffsets )
+				write( offset_ );
+
+			// Patch header
+			const std::streampos endPos_( mStream.tellp( ) );
+			mStream.seekp( mStart + static_cast<std::streamoff>( sizeof( std::uint32_t ) * 2 ) );
+			write( static_cast<std::uint64_t>( indexPos_ - mStart ) );
+			mStream.seekp( endPos_ );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	/*
+	 * snapshot_reader - restores graph of fast_ptr & rel_ptr objects from
+	 * snapshot_writer data.
+	 *
+	 * Reads directly from memory (for example, mmap'd file), without copying it.
+	 * Each object is created once, all pointers to it share the same counter.
+	 *
+	 * Loading is lazy: reading pointer loads only objects, reachable from it,
+	 * records are found by index. Records of other objects are skipped, so
+	 * their memory (pages) is not accessed.
+	 *
+	 * (?) Objects, found while loading the record, are loaded after it, so graph
+	 * depth doesn't use stack.
+	 * (!) Objects of the pointers, read in snapshot_traits#load, are not loaded
+	 * yet: don't access them there.
+	 * (!) Reader can't be used after exception, except destruction.
+	 * (?) Reader keeps a reference to every restored object, so counters are equal to
+	 * the saved ones only after reader is destroyed.
+	 * (!) Not thread-safe.
+	 *
+	 * @version 0.2.0
+	*/
+	class snapshot_reader final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Types
+		// ===========================================================
+
+		/* Restored object, type-erased */
+		struct snapshot_entry
+		{
+
+			/* snapshot_entry destructor */
+			virtual ~snapshot_entry( ) noexcept
+			{
+			}
+
+			/* Reads object fields */
+			virtual void load( snapshot_reader & pReader ) = 0;
+
+		};
+
+		/* Restored object */
+		template <typename T, template <typename> class P>
+		struct snapshot_object final : public snapshot_entry
+		{
+
+			/* Pointer, shared with restored graph */
+			P<T> mPointer;
+
+			/* snapshot_object constructor */
+			explicit snapshot_object( T *const pObject )
+				: mPointer( pObject )
+			{
+			}
+
+			/* Reads object fields */
+			virtual void load( snapshot_reader & pReader ) final
+			{ snapshot_traits<T>::load( pReader, mPointer.getRef( ) ); }
+
+		};
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Snapshot data */
+		const char *const mData;
+
+		/* Snapshot data size */
+		const std::size_t mSize;
+
+		/* Read position */
+		std::size_t mPosition;
+
+		/* Position of the record offsets */
+		std::size_t mIndex;
+
+		/* Restored objects, index = id - 1, null if not loaded */
+		std::vector<snapshot_entry*> mObjects;
+
+		/* Ids of the created objects, which records are not read */
+		std::vector<std::uint32_t> mPending;
+
+		/* Number of records being read, 0 at top level */
+		std::size_t mDepth;
+
+		/* Number of loaded objects */
+		std::size_t mLoaded;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Reads raw bytes */
+		void readBytes( void *const pData, const std::size_t pSize )
+		{
+
+			// Out of data
+			if ( pSize > mSize - mPosition )
+				throw std::runtime_error( "snapshot_reader: unexpected end of data" );
+
+			// Copy
+			std::memcpy( pData, mData + mPosition, pSize );
+			mPosition += pSize;
+
+		}
+
+		/* Skips bytes */
+		void skipBytes( const std::uint64_t pSize )
+		{
+
+			// Out of data
+			if ( pSize > mSize - mPosition )
+				throw std::runtime_error( "snapshot_reader: unexpected end of data" );
+
+			// Skip
+			mPosition += static_cast<std::size_t>( pSize );
+
+		}
+
+		/*
+		 * Reads records of the created objects.
+		 *
+		 * @throws - std::runtime_error on invalid data.
+		*/
+		void loadPending( )
+		{
+
+			while ( !mPending.empty( ) )
+			{
+
+				// Next
+				const std::uint32_t id_( mPending.back( ) );
+				mPending.pop_back( );
+
+				// Record offset
+				std::uint64_t offset_( 0 );
+				std::memcpy( &offset_, mData + mIndex + ( id_ - 1 ) * sizeof( std::uint64_t ), sizeof( std::uint64_t ) );
+				if ( offset_ >= mSize )
+					throw std::runtime_error( "snapshot_reader: invalid object record" );
+
+				// Record header
+				const std::size_t position_( mPosition );
+				mPosition = static_cast<std::size_t>( offset_ );
+				std::uint32_t recordId_( 0 );
+				std::uint64_t size_( 0 );
+				read( recordId_ );
+				read( size_ );
+				if ( recordId_ != id_ )
+					throw std::runtime_error( "snapshot_reader: invalid object record" );
+
+				// Fields
+				const std::size_t begin_( mPosition );
+				mDepth++;
+				mObjects[id_ - 1]->load( *this );
+				mDepth--;
+
+				// Check record size
+				if ( mPosition - begin_ != size_ )
+					throw std::runtime_error( "snapshot_reader: invalid object record" );
+
+				// Continue
+				mPosition = position_;
+				mLoaded++;
+
+			}
+
+		}
+
+		/*
+		 * Reads pointer, creates object if it wasn't created yet. At top level,
+		 * created objects are loaded.
+		 *
+		 * @param pPointer - pointer to set.
+		 * @throws - std::runtime_error on invalid data, or type mismatch.
+		*/
+		template <typename T, template <typename> class P>
+		void readObject( P<T> & pPointer )
+		{
+
+			// Id
+			std::uint32_t id_( 0 );
+			read( id_ );
+
+			// Top level, records are read by index
+			if ( mDepth < 1 )
+			{
+				std::uint64_t size_( 0 );
+				read( size_ );
+				skipBytes( size_ );
+			}
+
+			// Null
+			if ( id_ == 0 )
+			{
+				pPointer = P<T>( nullptr );
+				return;
+			}
+
+			// Unknown
+			if ( id_ > mObjects.size( ) )
+				throw std::runtime_error( "snapshot_reader: invalid object id" );
+
+			// Create object, registered before fields, so cycles are restored
+			snapshot_entry *& entry_lr( mObjects[id_ - 1] );
+			if ( entry_lr == nullptr )
+			{
+
+				// Hold, until registered
+				std::unique_ptr<T> object_( snapshot_traits<T>::create( ) );
+				std::unique_ptr<snapshot_object<T, P>> entry_( new snapshot_object<T, P>( object_.get( ) ) );
+				object_.release( );
+
+				// Register
+				mPending.push_back( id_ );
+				entry_lr = entry_.release( );
+
+			}
+
+			// Type check
+			snapshot_object<T, P> *const object_lp( dynamic_cast<snapshot_object<T, P>*>( entry_lr ) );
+			if ( object_lp == nullptr )
+				throw std::runtime_error( "snapshot_reader: object type mismatch" );
+
+			// Share
+			pPointer = object_lp->mPointer;
+
+			// Top level, load objects
+			if ( mDepth < 1 )
+				loadPending( );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructor & destructor
+		// ===========================================================
+
+		/*
+		 * snapshot_reader constructor, checks header & index.
+		 *
+		 * @param pData - snapshot data, must be valid while reading.
+		 * @param pSize - data size (bytes).
+		 * @throws - std::runtime_error, if data is not a finished snapshot.
+		*/
+		snapshot_reader( const void *const pData, const std::size_t pSize )
+			: mData( static_cast<const char*>( pData ) ),
+			mSize( pSize ),
+			mPosition( 0 ),
+			mIndex( 0 ),
+			mObjects( ),
+			mPending( ),
+			mDepth( 0 ),
+			mLoaded( 0 )
+		{
+
+			// Header
+			std::uint32_t magic_( 0 );
+			std::uint32_t version_( 0 );
+			std::uint64_t index_( 0 );
+			read( magic_ );
+			read( version_ );
+			read( index_ );
+
+			// Check
+			if ( magic_ != snapshot_writer::MAGIC || version_ != snapshot_writer::VERSION )
+				throw std::runtime_error( "snapshot_reader: unknown format" );
+			if ( index_ < mPosition || index_ > mSize - sizeof( std::uint64_t ) )
+				throw std::runtime_error( "snapshot_reader: invalid index" );
+
+			// Index
+			std::uint64_t count_( 0 );
+			std::memcpy( &count_, mData + index_, sizeof( std::uint64_t ) );
+			mIndex = static_cast<std::size_t>( index_ ) + sizeof( std::uint64_t );
+			if ( count_ > ( mSize - mIndex ) / sizeof( std::uint64_t ) )
+				throw std::runtime_error( "snapshot_reader: invalid index" );
+			mObjects.resize( static_cast<std::size_t>( count_ ), nullptr );
+
+		}
+
+		/* snapshot_reader destructor, releases reader references */
+		~snapshot_reader( ) noexcept
+		{
+
+			// Release
+			for ( snapshot_entry *const entry_lp : mObjects )
+				delete entry_lp;
+
+		}
+
+		// ===========================================================
+		// Deleted
+		// ===========================================================
+
+		/* @deleted snapshot_reader const copy constructor */
+		snapshot_reader( const snapshot_reader & ) = delete;
+
+		/* @deleted snapshot_reader const copy assignment operator */
+		snapshot_reader & operator=( const snapshot_reader & ) = delete;
+
+		// ===========================================================
+		// Getter & Setter
+		// ===========================================================
+
+		/* Returns number of objects in the snapshot */
+		const std::size_t count( ) const noexcept
+		{ return( mObjects.size( ) ); }
+
+		/* Returns number of loaded objects */
+		const std::size_t loaded( ) const noexcept
+		{ return( mLoaded ); }
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Reads number or enum value */
+		template <typename T>
+		void read( T & pValue )
+		{
+
+			// Only plain values
+			static_assert( std::is_arithmetic<T>::value || std::is_enum<T>::value, "snapshot_reader: use snapshot_traits for objects" );
+
+			// Read
+			readBytes( &pValue, sizeof( T ) );
+
+		}
+
+		/* Reads string */
+		void read( std::string & pValue )
+		{
+
+			// Size
+			std::uint64_t size_( 0 );
+			read( size_ );
+
+			// Out of data
+			if ( size_ > mSize - mPosition )
+				throw std::runtime_error( "snapshot_reader: unexpected end of data" );
+
+			// Characters
+			pValue.assign( mData + mPosition, static_cast<std::size_t>( size_ ) );
+			mPosition += static_cast<std::size_t>( size_ );
+
+		}
+
+		/*
+		 * Reads pointer, restores object if it wasn't restored yet.
+		 *
+		 * @param pPointer - pointer to set.
+		 * @throws - std::runtime_error on invalid data, or type mismatch.
+		*/
+		template <typename T>
+		void read( fast_ptr<T> & pPointer )
+		{ readObject<T, fast_ptr>( pPointer ); }
+
+		/*
+		 * Reads pointer, restores object if it wasn't restored yet. Object is
+		 * registered in the rel_ptr registry.
+		 *
+		 * @param pPointer - pointer to set.
+		 * @throws - std::runtime_error on invalid data, or type mismatch, mutex.
+		*/
+		template <typename T>
+		void read( rel_ptr<T> & pPointer )
+		{ readObject<T, rel_ptr>( pPointer ); }
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_SNAPSHOT_HXX_
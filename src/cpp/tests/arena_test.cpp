@@ -0,0 +1,163 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::uintptr_t
+#include <cstddef>
+#include <cstdint>
+
+// Include arena
+#include "../arena.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Counted object, records destruction order */
+struct arena_object
+{
+
+	/* Live objects */
+	static int LIVE;
+
+	/* Last destroyed value */
+	static int LAST;
+
+	/* Value */
+	const int mValue;
+
+	/* arena_object constructor */
+	explicit arena_object( const int pValue )
+		: mValue( pValue )
+	{ LIVE++; }
+
+	/* arena_object copy constructor, used by promote */
+	arena_object( const arena_object & pOther )
+		: mValue( pOther.mValue )
+	{ LIVE++; }
+
+	/* arena_object destructor */
+	~arena_object( )
+	{
+		LIVE--;
+		LAST = mValue;
+	}
+
+};
+
+int arena_object::LIVE( 0 );
+int arena_object::LAST( 0 );
+
+/* Throws from constructor */
+struct failing_object
+{
+
+	/* failing_object constructor */
+	failing_object( )
+	{ throw 1; }
+
+};
+
+/* Objects are destroyed at once by reset & destructor, in reverse order */
+static void reset_test( )
+{
+
+	{
+		c0de4un::arena arena_( 64 );
+		c0de4un::arena_ptr<arena_object> first_( arena_.make<arena_object>( 1 ) );
+
+		// More objects than a single block holds
+		for ( int i = 2; i <= 100; i++ )
+			arena_.make<arena_object>( i );
+		_C0DE4UN_TEST_CHECK_( arena_object::LIVE == 100 && first_->mValue == 1 );
+
+		// Reset, first object is destroyed last
+		arena_.reset( );
+		_C0DE4UN_TEST_CHECK_( arena_object::LIVE == 0 && arena_object::LAST == 1 );
+
+		// Arena is reusable
+		arena_.make<arena_object>( 7 );
+		_C0DE4UN_TEST_CHECK_( arena_object::LIVE == 1 );
+	}
+
+	// Destructor
+	_C0DE4UN_TEST_CHECK_( arena_object::LIVE == 0 && arena_object::LAST == 7 );
+
+}
+
+/* Raw memory & trivial objects respect alignment */
+static void allocate_test( )
+{
+
+	c0de4un::arena arena_( 16 );
+
+	arena_.allocate( 1, 1 );
+	void *const aligned_lp( arena_.allocate( 8, 64 ) );
+	_C0DE4UN_TEST_CHECK_( reinterpret_cast<std::uintptr_t>( aligned_lp ) % 64 == 0 );
+
+	// Larger than block
+	void *const large_lp( arena_.allocate( 1024 ) );
+	_C0DE4UN_TEST_CHECK_( large_lp != nullptr );
+
+	c0de4un::arena_ptr<double> value_( arena_.make<double>( 2.5 ) );
+	_C0DE4UN_TEST_CHECK_( value_.getRef( ) == 2.5 );
+	_C0DE4UN_TEST_CHECK_( reinterpret_cast<std::uintptr_t>( value_.getPtr( ) ) % alignof( double ) == 0 );
+
+}
+
+/* Constructor exception doesn't register destructor */
+static void exception_test( )
+{
+
+	c0de4un::arena arena_;
+	arena_.make<arena_object>( 1 );
+
+	bool thrown_( false );
+	try
+	{
+		arena_.make<failing_object>( );
+	}
+	catch ( ... )
+	{
+		thrown_ = true;
+	}
+
+	_C0DE4UN_TEST_CHECK_( thrown_ );
+	arena_.reset( );
+	_C0DE4UN_TEST_CHECK_( arena_object::LIVE == 0 );
+
+}
+
+/* Promoted object outlives arena */
+static void promote_test( )
+{
+
+	c0de4un::fast_ptr<arena_object> promoted_;
+	{
+		c0de4un::arena arena_;
+		c0de4un::arena_ptr<arena_object> object_( arena_.make<arena_object>( 5 ) );
+		promoted_ = arena_.promote( object_ );
+		_C0DE4UN_TEST_CHECK_( arena_object::LIVE == 2 );
+	}
+
+	_C0DE4UN_TEST_CHECK_( arena_object::LIVE == 1 && promoted_->mValue == 5 );
+	promoted_.reset( );
+	_C0DE4UN_TEST_CHECK_( arena_object::LIVE == 0 );
+
+}
+
+/* MAIN */
+int main( )
+{
+
+	reset_test( );
+	allocate_test( );
+	exception_test( );
+	promote_test( );
+
+	// Return result
+	return( c0de4un::test::result( "arena_test" ) );
+
+}
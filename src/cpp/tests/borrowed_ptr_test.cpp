@@ -0,0 +1,145 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Borrow Check Mode
+#define _C0DE4UN_POINTERS_BORROW_CHECK_ENABLED_
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::is_constructible
+#include <type_traits>
+
+#ifndef _WIN32
+// Include SIGABRT
+#include <csignal>
+
+// Include fork, waitpid
+#include <sys/wait.h>
+#include <unistd.h>
+#endif // !_WIN32
+
+// Include borrowed_ptr
+#include "../borrowed_ptr.hxx"
+
+// Include cow_ptr
+#include "../cow_ptr.hxx"
+
+// Include compressed_ptr
+#include "../compressed_ptr.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Object */
+struct borrowed_object
+{
+
+	/* Value */
+	int mValue;
+
+};
+
+/* Type-Alias for borrowed pointer */
+using borrowed_object_ptr = c0de4un::borrowed_ptr<borrowed_object>;
+
+static_assert( sizeof( borrowed_object_ptr ) == sizeof( borrowed_object* ), "borrowed_ptr is a raw-pointer" );
+static_assert( !std::is_constructible<borrowed_object_ptr, c0de4un::fast_ptr<borrowed_object>&&>::value, "temporary fast_ptr can't be borrowed" );
+
+/* Returns value of the borrowed object */
+static int value( const borrowed_object_ptr pObject )
+{ return( pObject->mValue ); }
+
+/* Returns value of the borrowed const object */
+static int constValue( const c0de4un::borrowed_ptr<const borrowed_object> pObject )
+{ return( pObject.getRef( ).mValue ); }
+
+/* Borrow from owning pointers */
+static void borrow_test( )
+{
+
+	c0de4un::fast_ptr<borrowed_object> fast_( new borrowed_object{ 1 } );
+	c0de4un::cow_ptr<borrowed_object> cow_( new borrowed_object{ 2 } );
+	c0de4un::compressed_ptr<borrowed_object> compressed_( c0de4un::compressed_ptr<borrowed_object>::make( borrowed_object{ 3 } ) );
+	borrowed_object raw_{ 4 };
+
+	_C0DE4UN_TEST_CHECK_( value( fast_ ) == 1 );
+	_C0DE4UN_TEST_CHECK_( constValue( cow_ ) == 2 );
+	_C0DE4UN_TEST_CHECK_( value( compressed_ ) == 3 );
+	_C0DE4UN_TEST_CHECK_( value( borrowed_object_ptr( &raw_ ) ) == 4 );
+
+	// Copy & assignment
+	borrowed_object_ptr first_( fast_ );
+	borrowed_object_ptr second_( first_ );
+	_C0DE4UN_TEST_CHECK_( second_ == first_ && second_.get( ) == fast_.getPtr( ) );
+	second_ = borrowed_object_ptr( compressed_ );
+	_C0DE4UN_TEST_CHECK_( *second_ == compressed_.getPtr( ) );
+
+	// Null
+	borrowed_object_ptr null_;
+	_C0DE4UN_TEST_CHECK_( null_ == nullptr && first_ != nullptr );
+
+}
+
+/* Released objects, which are not borrowed anymore */
+static void release_test( )
+{
+
+	c0de4un::fast_ptr<borrowed_object> fast_( new borrowed_object{ 1 } );
+	c0de4un::compressed_ptr<borrowed_object> compressed_( c0de4un::compressed_ptr<borrowed_object>::make( borrowed_object{ 2 } ) );
+	{
+		borrowed_object_ptr first_( fast_ );
+		borrowed_object_ptr second_( compressed_ );
+		borrowed_object_ptr third_( first_ );
+		third_ = second_;
+	}
+
+	// Doesn't abort
+	fast_.reset( );
+	compressed_.reset( );
+	_C0DE4UN_TEST_CHECK_( fast_ == nullptr && compressed_ == nullptr );
+
+}
+
+#ifndef _WIN32
+/* Release of the borrowed object aborts */
+static void abort_test( )
+{
+
+	const pid_t child_( fork( ) );
+	if ( child_ == 0 )
+	{
+		c0de4un::fast_ptr<borrowed_object> fast_( new borrowed_object{ 1 } );
+		borrowed_object_ptr borrowed_( fast_ );
+		fast_.reset( );
+		_exit( 0 );
+	}
+
+	int status_( 0 );
+	_C0DE4UN_TEST_CHECK_( child_ > 0 && waitpid( child_, &status_, 0 ) == child_ );
+	_C0DE4UN_TEST_CHECK_( WIFSIGNALED( status_ ) && WTERMSIG( status_ ) == SIGABRT );
+
+}
+#endif // !_WIN32
+
+/* MAIN */
+int main( )
+{
+
+	borrow_test( );
+	release_test( );
+#ifndef _WIN32
+	abort_test( );
+#endif // !_WIN32
+
+	// Release compressed_heap range
+	c0de4un::ptr_registry<c0de4un::compressed_heap>::shutdown( );
+
+	// Return result
+	return( c0de4un::test::result( "borrowed_ptr_test" ) );
+
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::uint32_t, std::uintptr_t
+#include <cstdint>
+
+// Include std::move
+#include <utility>
+
+// Include std::vector
+#include <vector>
+
+// Include compressed_ptr
+#include "../compressed_ptr.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Counted object */
+struct compressed_object
+{
+
+	/* Live objects */
+	static int LIVE;
+
+	/* Value */
+	const int mValue;
+
+	/* compressed_object constructor */
+	explicit compressed_object( const int pValue )
+		: mValue( pValue )
+	{ LIVE++; }
+
+	/* compressed_object destructor */
+	~compressed_object( )
+	{ LIVE--; }
+
+};
+
+int compressed_object::LIVE( 0 );
+
+/* Object, larger than small block */
+struct large_object
+{
+
+	/* Payload */
+	char mPayload[1024];
+
+};
+
+/* Throws from constructor */
+struct failing_object
+{
+
+	/* failing_object constructor */
+	failing_object( )
+	{ throw 1; }
+
+};
+
+/* Type-Alias for pointer */
+using compressed_object_ptr = c0de4un::compressed_ptr<compressed_object>;
+
+static_assert( sizeof( compressed_object_ptr ) == sizeof( std::uint32_t ), "compressed_ptr is 32-bit offset" );
+
+/* Shared ownership */
+static void pointer_test( )
+{
+
+	{
+		compressed_object_ptr first_( compressed_object_ptr::make( 1 ) );
+		_C0DE4UN_TEST_CHECK_( first_ != nullptr && first_.getOffset( ) != 0 && first_->mValue == 1 );
+		_C0DE4UN_TEST_CHECK_( reinterpret_cast<std::uintptr_t>( first_.getPtr( ) ) % alignof( compressed_object ) == 0 );
+
+		// Copy
+		compressed_object_ptr second_( first_ );
+		_C0DE4UN_TEST_CHECK_( second_ == first_ && first_.count( ) == 2 );
+
+		// Move
+		compressed_object_ptr third_( std::move( second_ ) );
+		_C0DE4UN_TEST_CHECK_( second_ == nullptr && first_.count( ) == 2 );
+
+		// Assignment releases previous object
+		third_ = compressed_object_ptr::make( 2 );
+		_C0DE4UN_TEST_CHECK_( compressed_object::LIVE == 2 && first_.count( ) == 1 );
+		first_ = third_;
+		_C0DE4UN_TEST_CHECK_( compressed_object::LIVE == 1 && third_.count( ) == 2 && first_->mValue == 2 );
+
+		first_.reset( );
+		_C0DE4UN_TEST_CHECK_( first_ == nullptr && first_.getPtr( ) == nullptr );
+	}
+
+	_C0DE4UN_TEST_CHECK_( compressed_object::LIVE == 0 );
+
+}
+
+/* Counter doesn't wrap after 16-bit range, object is deleted with last copy */
+static void counter_test( )
+{
+
+	compressed_object_ptr object_( compressed_object_ptr::make( 1 ) );
+	{
+		std::vector<compressed_object_ptr> copies_( 70000, object_ );
+		_C0DE4UN_TEST_CHECK_( object_.count( ) == 70001 );
+
+		object_.reset( );
+		copies_.resize( 1 );
+		_C0DE4UN_TEST_CHECK_( compressed_object::LIVE == 1 && copies_[0].count( ) == 1 );
+	}
+
+	_C0DE4UN_TEST_CHECK_( compressed_object::LIVE == 0 );
+
+}
+
+/* Released blocks are reused by size */
+static void reuse_test( )
+{
+
+	std::uint32_t small_( 0 );
+	std::uint32_t large_( 0 );
+	{
+		compressed_object_ptr object_( compressed_object_ptr::make( 1 ) );
+		c0de4un::compressed_ptr<large_object> large_object_( c0de4un::compressed_ptr<large_object>::make( ) );
+		small_ = object_.getOffset( );
+		large_ = large_object_.getOffset( );
+	}
+
+	compressed_object_ptr object_( compressed_object_ptr::make( 2 ) );
+	c0de4un::compressed_ptr<large_object> large_object_( c0de4un::compressed_ptr<large_object>::make( ) );
+	_C0DE4UN_TEST_CHECK_( object_.getOffset( ) == small_ && large_object_.getOffset( ) == large_ );
+
+	// Constructor exception releases block
+	bool thrown_( false );
+	try
+	{
+		c0de4un::compressed_ptr<failing_object>::make( );
+	}
+	catch ( ... )
+	{
+		thrown_ = true;
+	}
+	_C0DE4UN_TEST_CHECK_( thrown_ );
+
+	// Many objects
+	std::vector<compressed_object_ptr> objects_;
+	for ( int i = 0; i < 100000; i++ )
+		objects_.push_back( compressed_object_ptr::make( i ) );
+	_C0DE4UN_TEST_CHECK_( compressed_object::LIVE == 100001 && objects_.back( )->mValue == 99999 );
+
+}
+
+/* MAIN */
+int main( )
+{
+
+	pointer_test( );
+	counter_test( );
+	reuse_test( );
+
+	// Release range
+	_C0DE4UN_TEST_CHECK_( compressed_object::LIVE == 0 );
+	c0de4un::ptr_registry<c0de4un::compressed_heap>::shutdown( );
+
+	// Return result
+	return( c0de4un::test::result( "compressed_ptr_test" ) );
+
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include cow_ptr
+#include "../cow_ptr.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Counted object */
+struct cow_object
+{
+
+	/* Live objects */
+	static int LIVE;
+
+	/* Copies */
+	static int COPIES;
+
+	/* Value */
+	int mValue;
+
+	/* cow_object constructor */
+	explicit cow_object( const int pValue )
+		: mValue( pValue )
+	{ LIVE++; }
+
+	/* cow_object const copy constructor */
+	cow_object( const cow_object & pOther )
+		: mValue( pOther.mValue )
+	{
+		LIVE++;
+		COPIES++;
+	}
+
+	/* cow_object destructor */
+	virtual ~cow_object( )
+	{ LIVE--; }
+
+	/* Returns kind of the object */
+	virtual const int kind( ) const noexcept
+	{ return( 0 ); }
+
+};
+
+int cow_object::LIVE( 0 );
+int cow_object::COPIES( 0 );
+
+/* Derived object, sliced by default cow_traits */
+struct derived_object final : public cow_object
+{
+
+	/* derived_object constructor */
+	explicit derived_object( const int pValue )
+		: cow_object( pValue )
+	{
+	}
+
+	/* Returns kind of the object */
+	virtual const int kind( ) const noexcept override
+	{ return( 1 ); }
+
+};
+
+/* Polymorphic object */
+struct shape
+{
+
+	/* shape destructor */
+	virtual ~shape( )
+	{
+	}
+
+	/* Returns copy of the object */
+	virtual shape *const clone( ) const = 0;
+
+	/* Returns kind of the object */
+	virtual const int kind( ) const noexcept = 0;
+
+};
+
+/* shape implementation */
+struct circle final : public shape
+{
+
+	/* Returns copy of the object */
+	virtual shape *const clone( ) const override
+	{ return( new circle( *this ) ); }
+
+	/* Returns kind of the object */
+	virtual const int kind( ) const noexcept override
+	{ return( 2 ); }
+
+};
+
+namespace c0de4un
+{
+
+	/* shape is copied by clone */
+	template <>
+	struct cow_traits<shape>
+	{
+		/* Returns copy of the object */
+		static shape *const clone( const shape & pObject )
+		{ return( pObject.clone( ) ); }
+	};
+
+} // namespace c0de4un
+
+/* Type-Alias for pointer */
+using cow_object_ptr = c0de4un::cow_ptr<cow_object>;
+
+/* Copies share object, until modification */
+static void copy_test( )
+{
+
+	{
+		cow_object_ptr first_( cow_object_ptr::make( 1 ) );
+		_C0DE4UN_TEST_CHECK_( first_.isUnique( ) );
+
+		// Unique object is not copied
+		first_.getMutable( )->mValue = 2;
+		_C0DE4UN_TEST_CHECK_( cow_object::COPIES == 0 && first_->mValue == 2 );
+
+		// Copy shares object
+		cow_object_ptr second_( first_ );
+		_C0DE4UN_TEST_CHECK_( second_ == first_ && !first_.isUnique( ) && cow_object::COPIES == 0 );
+
+		// Modification copies
+		second_.getMutable( )->mValue = 3;
+		_C0DE4UN_TEST_CHECK_( cow_object::COPIES == 1 && cow_object::LIVE == 2 );
+		_C0DE4UN_TEST_CHECK_( first_->mValue == 2 && second_->mValue == 3 );
+		_C0DE4UN_TEST_CHECK_( first_.isUnique( ) && second_.isUnique( ) );
+
+		// Now unique, not copied again
+		second_.getMutable( )->mValue = 4;
+		_C0DE4UN_TEST_CHECK_( cow_object::COPIES == 1 );
+
+		// Null
+		cow_object_ptr null_;
+		_C0DE4UN_TEST_CHECK_( null_ == nullptr && null_.isUnique( ) && null_.getMutable( ) == nullptr );
+
+		first_.reset( );
+		_C0DE4UN_TEST_CHECK_( cow_object::LIVE == 1 );
+	}
+
+	_C0DE4UN_TEST_CHECK_( cow_object::LIVE == 0 );
+
+}
+
+/* Object, shared by fast_ptr, is not modified */
+static void shared_test( )
+{
+
+	{
+		c0de4un::fast_ptr<cow_object> shared_( new cow_object( 1 ) );
+		cow_object_ptr cow_( shared_ );
+		_C0DE4UN_TEST_CHECK_( !cow_.isUnique( ) && cow_.getShared( ) == shared_ );
+
+		cow_.getMutable( )->mValue = 2;
+		_C0DE4UN_TEST_CHECK_( shared_->mValue == 1 && cow_->mValue == 2 );
+	}
+
+	_C0DE4UN_TEST_CHECK_( cow_object::LIVE == 0 );
+
+}
+
+/* Copy with cow_traits */
+static void traits_test( )
+{
+
+	// Copy constructor of the stored type
+	c0de4un::cow_ptr<cow_object> derived_( new derived_object( 1 ) );
+	c0de4un::cow_ptr<cow_object> copy_( derived_ );
+	_C0DE4UN_TEST_CHECK_( copy_.getMutable( )->kind( ) == 0 );
+
+	// Specialized clone
+	c0de4un::cow_ptr<shape> first_( new circle( ) );
+	c0de4un::cow_ptr<shape> second_( first_ );
+	shape *const mutable_lp( second_.getMutable( ) );
+	_C0DE4UN_TEST_CHECK_( mutable_lp != first_.get( ) && mutable_lp->kind( ) == 2 );
+
+}
+
+/* MAIN */
+int main( )
+{
+
+	copy_test( );
+	shared_test( );
+	traits_test( );
+
+	// Return result
+	return( c0de4un::test::result( "cow_ptr_test" ) );
+
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::chrono
+#include <chrono>
+
+// Include std::vector
+#include <vector>
+
+// Include cycle_collector
+#include "../cycle_collector.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Graph node, fast_ptr edge */
+struct fast_node
+{
+
+	/* Live objects */
+	static int LIVE;
+
+	/* Edge */
+	c0de4un::fast_ptr<fast_node> mNext;
+
+	/* fast_node constructor */
+	fast_node( )
+		: mNext( )
+	{ LIVE++; }
+
+	/* fast_node destructor */
+	~fast_node( )
+	{ LIVE--; }
+
+	/* Visits edges */
+	void trace( c0de4un::cycle_tracer & pTracer )
+	{ pTracer.visit( mNext ); }
+
+};
+
+int fast_node::LIVE( 0 );
+
+/* Graph node, rel_ptr edge */
+struct rel_node
+{
+
+	/* Live objects */
+	static int LIVE;
+
+	/* Edge */
+	c0de4un::rel_ptr<rel_node> mNext;
+
+	/* rel_node constructor */
+	rel_node( )
+		: mNext( nullptr )
+	{ LIVE++; }
+
+	/* rel_node destructor */
+	~rel_node( )
+	{ LIVE--; }
+
+	/* Visits edges */
+	void trace( c0de4un::cycle_tracer & pTracer )
+	{ pTracer.visit( mNext ); }
+
+};
+
+int rel_node::LIVE( 0 );
+
+/* Creates ring of fast_node, returns first node */
+static c0de4un::fast_ptr<fast_node> make_ring( const int pSize )
+{
+
+	c0de4un::fast_ptr<fast_node> first_( new fast_node( ) );
+	c0de4un::fast_ptr<fast_node> last_( first_ );
+	for ( int i = 1; i < pSize; i++ )
+	{
+		last_.getPtr( )->mNext = c0de4un::fast_ptr<fast_node>( new fast_node( ) );
+		last_ = last_.getPtr( )->mNext;
+	}
+	last_.getPtr( )->mNext = first_;
+
+	return( first_ );
+
+}
+
+/* Garbage cycle is released, used one is kept */
+static void collect_test( )
+{
+
+	c0de4un::cycle_collector collector_;
+
+	c0de4un::fast_ptr<fast_node> used_( make_ring( 3 ) );
+	collector_.suspect( used_ );
+	collector_.suspect( make_ring( 2 ) );
+	_C0DE4UN_TEST_CHECK_( fast_node::LIVE == 5 && collector_.pending( ) == 2 );
+
+	collector_.collect( );
+	_C0DE4UN_TEST_CHECK_( fast_node::LIVE == 3 && collector_.collected( ) == 2 && collector_.pending( ) == 0 );
+
+	// Break cycle, release
+	used_.getPtr( )->mNext.reset( );
+	used_.reset( );
+	_C0DE4UN_TEST_CHECK_( fast_node::LIVE == 0 );
+
+}
+
+/* Root is processed in many steps */
+static void step_test( )
+{
+
+	c0de4un::cycle_collector collector_;
+	collector_.suspect( make_ring( 200 ) );
+
+	// Each step processes at least one object
+	int steps_( 1 );
+	while ( collector_.collectStep( std::chrono::microseconds( 0 ) ) )
+		steps_++;
+
+	_C0DE4UN_TEST_CHECK_( steps_ > 200 );
+	_C0DE4UN_TEST_CHECK_( fast_node::LIVE == 0 && collector_.collected( ) == 200 );
+
+}
+
+/* Graph changed between steps: garbage candidates are verified */
+static void change_test( )
+{
+
+	c0de4un::cycle_collector collector_;
+	fast_node * first_lp( nullptr );
+	{
+		c0de4un::fast_ptr<fast_node> ring_( make_ring( 50 ) );
+		first_lp = ring_.getPtr( );
+		collector_.suspect( ring_ );
+	}
+
+	// Start marking
+	for ( int i = 0; i < 5; i++ )
+		collector_.collectStep( std::chrono::microseconds( 0 ) );
+
+	// New external reference to the marked object
+	c0de4un::fast_ptr<fast_node> used_( first_lp->mNext );
+
+	// Verification fails, root is processed again & kept
+	collector_.collect( );
+	_C0DE4UN_TEST_CHECK_( fast_node::LIVE == 50 && collector_.collected( ) == 0 && collector_.pending( ) == 0 );
+
+	// Dropped
+	used_.reset( );
+	collector_.suspect( first_lp->mNext );
+	collector_.collect( );
+	_C0DE4UN_TEST_CHECK_( fast_node::LIVE == 0 && collector_.collected( ) == 50 );
+
+}
+
+/* rel_ptr edges & registry roots */
+static void rel_ptr_test( )
+{
+
+	// Chain: destructor releases rel_ptr of the same type
+	{
+		c0de4un::rel_ptr<rel_node> first_( new rel_node( ) );
+		first_->mNext = c0de4un::rel_ptr<rel_node>( new rel_node( ) );
+	}
+	_C0DE4UN_TEST_CHECK_( rel_node::LIVE == 0 );
+
+	// Cycle & used object
+	c0de4un::rel_ptr<rel_node> used_( new rel_node( ) );
+	{
+		c0de4un::rel_ptr<rel_node> first_( new rel_node( ) );
+		c0de4un::rel_ptr<rel_node> second_( new rel_node( ) );
+		first_->mNext = second_;
+		second_->mNext = first_;
+	}
+	_C0DE4UN_TEST_CHECK_( rel_node::LIVE == 3 );
+
+	c0de4un::cycle_collector collector_;
+	collector_.suspectRegistry<rel_node>( );
+	_C0DE4UN_TEST_CHECK_( collector_.pending( ) == 3 );
+
+	collector_.collect( );
+	_C0DE4UN_TEST_CHECK_( rel_node::LIVE == 1 && collector_.collected( ) == 2 );
+
+	used_ = c0de4un::rel_ptr<rel_node>( nullptr );
+	_C0DE4UN_TEST_CHECK_( rel_node::LIVE == 0 );
+
+}
+
+/* MAIN */
+int main( )
+{
+
+	collect_test( );
+	step_test( );
+	change_test( );
+	rel_ptr_test( );
+
+	c0de4un::rel_ptr<rel_node>::shutdown( );
+
+	// Return result
+	return( c0de4un::test::result( "cycle_collector_test" ) );
+
+}
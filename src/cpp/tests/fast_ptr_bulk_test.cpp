@@ -0,0 +1,171 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::overflow_error
+#include <stdexcept>
+
+// Include std::vector
+#include <vector>
+
+// Include fast_ptr_bulk
+#include "../fast_ptr_bulk.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Counted object */
+struct bulk_object
+{
+
+	/* Live objects */
+	static int LIVE;
+
+	/* bulk_object constructor */
+	bulk_object( )
+	{ LIVE++; }
+
+	/* bulk_object destructor */
+	~bulk_object( )
+	{ LIVE--; }
+
+};
+
+int bulk_object::LIVE( 0 );
+
+/* Type-Alias for pointer */
+using bulk_ptr = c0de4un::fast_ptr<bulk_object>;
+
+/* Returns true, if retain_n throws std::overflow_error */
+static bool overflows( const std::vector<bulk_ptr> & pPointers, const unsigned int pReferences )
+{
+
+	try
+	{
+		c0de4un::retain_n( pPointers.data( ), pPointers.size( ), pReferences );
+	}
+	catch ( const std::overflow_error & )
+	{
+		return( true );
+	}
+
+	// Return result
+	return( false );
+
+}
+
+/* Copy, adopt & release, small & grouped arrays */
+static void copy_test( )
+{
+
+	for ( std::size_t size_ : { std::size_t( 8 ), std::size_t( 100 ) } )
+	{
+
+		// Two objects, interleaved, & nulls
+		bulk_ptr first_( new bulk_object( ) );
+		bulk_ptr second_( new bulk_object( ) );
+		std::vector<bulk_ptr> source_( size_ );
+		for ( std::size_t i = 0; i < size_; i += 3 )
+		{
+			source_[i] = first_;
+			if ( i + 1 < size_ )
+				source_[i + 1] = second_;
+		}
+		const unsigned int firstCount_( first_.count( ) );
+		const unsigned int secondCount_( second_.count( ) );
+
+		// Copy
+		std::vector<bulk_ptr> copy_( size_ );
+		c0de4un::copy_n( source_.data( ), size_, copy_.data( ) );
+		_C0DE4UN_TEST_CHECK_( first_.count( ) == 2 * firstCount_ - 1 && second_.count( ) == 2 * secondCount_ - 1 );
+
+		// Fan-out
+		std::vector<bulk_ptr> workers_[2] = { std::vector<bulk_ptr>( size_ ), std::vector<bulk_ptr>( size_ ) };
+		c0de4un::retain_n( source_.data( ), size_, 2 );
+		c0de4un::adopt_n( source_.data( ), size_, workers_[0].data( ) );
+		c0de4un::adopt_n( source_.data( ), size_, workers_[1].data( ) );
+		_C0DE4UN_TEST_CHECK_( workers_[1][0] == first_ && workers_[1][1] == second_ && workers_[1][2] == nullptr );
+
+		// Release
+		c0de4un::release_n( workers_[0].data( ), size_ );
+		c0de4un::release_n( workers_[1].data( ), size_ );
+		c0de4un::release_n( copy_.data( ), size_ );
+		_C0DE4UN_TEST_CHECK_( first_.count( ) == firstCount_ && second_.count( ) == secondCount_ );
+		_C0DE4UN_TEST_CHECK_( copy_[0] == nullptr );
+
+		// Last references free objects
+		first_.reset( );
+		second_.reset( );
+		c0de4un::release_n( source_.data( ), size_ );
+		_C0DE4UN_TEST_CHECK_( bulk_object::LIVE == 0 );
+
+	}
+
+}
+
+/* Counter limit */
+static void overflow_test( )
+{
+
+	for ( std::size_t size_ : { std::size_t( 10 ), std::size_t( 1000 ) } )
+	{
+
+		bulk_ptr object_( new bulk_object( ) );
+		bulk_ptr other_( new bulk_object( ) );
+		std::vector<bulk_ptr> pointers_( size_, object_ );
+		pointers_[0] = other_;
+		const unsigned int count_( object_.count( ) );
+
+		// Fan-out wraps 16-bit counter: nothing is added
+		_C0DE4UN_TEST_CHECK_( overflows( pointers_, 65535 / static_cast<unsigned int>( size_ - 1 ) + 1 ) );
+		_C0DE4UN_TEST_CHECK_( object_.count( ) == count_ && other_.count( ) == 2 );
+
+		// Sum equal to FAST_PTR_IMMORTAL is overflow too
+		const unsigned int last_( c0de4un::FAST_PTR_IMMORTAL - count_ );
+		std::vector<bulk_ptr> single_( 1, object_ );
+		_C0DE4UN_TEST_CHECK_( overflows( single_, last_ ) );
+		_C0DE4UN_TEST_CHECK_( !object_.isImmortal( ) && object_.count( ) == count_ + 1 );
+
+		// Max
+		_C0DE4UN_TEST_CHECK_( !overflows( single_, last_ - 2 ) );
+		_C0DE4UN_TEST_CHECK_( object_.count( ) == c0de4un::FAST_PTR_IMMORTAL - 1 );
+		for ( unsigned int i = 0; i < last_ - 2; i++ )
+			single_[0].getBlock( )->mCounter--;
+
+	}
+
+	_C0DE4UN_TEST_CHECK_( bulk_object::LIVE == 0 );
+
+}
+
+/* Immortal counters are not changed */
+static void immortal_test( )
+{
+
+	bulk_ptr object_( new bulk_object( ) );
+	object_.makeImmortal( );
+	std::vector<bulk_ptr> pointers_( 100, object_ );
+	c0de4un::retain_n( pointers_.data( ), pointers_.size( ), 1000 );
+	c0de4un::release_n( pointers_.data( ), pointers_.size( ) );
+	_C0DE4UN_TEST_CHECK_( object_.isImmortal( ) && bulk_object::LIVE == 1 );
+
+}
+
+/* MAIN */
+int main( )
+{
+
+	copy_test( );
+	overflow_test( );
+	immortal_test( );
+
+	// Return result
+	return( c0de4un::test::result( "fast_ptr_bulk_test" ) );
+
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::vector
+#include <vector>
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+// Include std::thread
+#include <thread>
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+#ifndef _WIN32
+// Include SIGABRT
+#include <csignal>
+
+// Include fork, waitpid
+#include <sys/wait.h>
+#include <unistd.h>
+#endif // !_WIN32
+
+// Include fast_ptr_bulk
+#include "../fast_ptr_bulk.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Counted object */
+struct immortal_object
+{
+
+	/* Live objects */
+	static int LIVE;
+
+	/* immortal_object constructor */
+	immortal_object( )
+	{ LIVE++; }
+
+	/* immortal_object destructor */
+	~immortal_object( )
+	{ LIVE--; }
+
+};
+
+int immortal_object::LIVE( 0 );
+
+/* Type-Alias for pointer */
+using immortal_ptr = c0de4un::fast_ptr<immortal_object>;
+
+/* Static object, never deleted */
+static immortal_object OBJECT;
+
+/* Control block of the static object */
+static c0de4un::fast_ptr_block BLOCK;
+
+/* Returns pointer to the static object */
+static immortal_ptr getObject( )
+{
+
+	immortal_ptr result_( &OBJECT, &BLOCK );
+	result_.makeImmortal( );
+
+	// Return result
+	return( result_ );
+
+}
+
+/* Copies & releases don't change counter, object is not deleted */
+static void counter_test( )
+{
+
+	immortal_ptr first_( getObject( ) );
+	_C0DE4UN_TEST_CHECK_( first_.isImmortal( ) && first_.count( ) == c0de4un::FAST_PTR_IMMORTAL );
+
+	{
+		immortal_ptr second_( first_ );
+		immortal_ptr third_;
+		third_ = second_;
+		_C0DE4UN_TEST_CHECK_( third_.count( ) == c0de4un::FAST_PTR_IMMORTAL );
+	}
+
+	first_.reset( );
+	_C0DE4UN_TEST_CHECK_( immortal_object::LIVE == 1 && BLOCK.isImmortal( ) );
+
+	// Null
+	immortal_ptr null_;
+	null_.makeImmortal( );
+	_C0DE4UN_TEST_CHECK_( !null_.isImmortal( ) );
+
+	// Counted object
+	immortal_ptr counted_( new immortal_object( ) );
+	_C0DE4UN_TEST_CHECK_( !counted_.isImmortal( ) );
+	counted_.reset( );
+	_C0DE4UN_TEST_CHECK_( immortal_object::LIVE == 1 );
+
+}
+
+/* Bulk operations skip immortal objects */
+static void bulk_test( )
+{
+
+	std::vector<immortal_ptr> pointers_( 16 );
+	for ( std::size_t i = 0; i < pointers_.size( ); i++ )
+		pointers_[i] = i % 2 == 0 ? getObject( ) : immortal_ptr( new immortal_object( ) );
+
+	// Copy, one counter update per counted object
+	std::vector<immortal_ptr> copies_( pointers_.size( ) );
+	c0de4un::copy_n( pointers_.data( ), pointers_.size( ), copies_.data( ) );
+	_C0DE4UN_TEST_CHECK_( copies_[0].count( ) == c0de4un::FAST_PTR_IMMORTAL && copies_[1].count( ) == 2 );
+
+	// Release
+	c0de4un::release_n( copies_.data( ), copies_.size( ) );
+	_C0DE4UN_TEST_CHECK_( pointers_[0].count( ) == c0de4un::FAST_PTR_IMMORTAL && pointers_[1].count( ) == 1 );
+	c0de4un::release_n( pointers_.data( ), pointers_.size( ) );
+	_C0DE4UN_TEST_CHECK_( pointers_[0] == nullptr && immortal_object::LIVE == 1 );
+
+}
+
+/* Mortal object keeps FAST_PTR_IMMORTAL - 1 instances, next copy aborts */
+static void limit_test( )
+{
+
+	const immortal_ptr object_( new immortal_object( ) );
+	std::vector<immortal_ptr> copies_( c0de4un::FAST_PTR_IMMORTAL - 2, object_ );
+	_C0DE4UN_TEST_CHECK_( object_.count( ) == c0de4un::FAST_PTR_IMMORTAL - 1 && !object_.isImmortal( ) );
+
+#ifndef _WIN32
+	const pid_t child_( fork( ) );
+	if ( child_ == 0 )
+	{
+		immortal_ptr copy_( object_ );
+		_exit( 0 );
+	}
+
+	int status_( 0 );
+	_C0DE4UN_TEST_CHECK_( child_ > 0 && waitpid( child_, &status_, 0 ) == child_ );
+	_C0DE4UN_TEST_CHECK_( WIFSIGNALED( status_ ) && WTERMSIG( status_ ) == SIGABRT );
+#endif // !_WIN32
+
+	// Copies are released, object is kept by the last instance
+	copies_.clear( );
+	_C0DE4UN_TEST_CHECK_( object_.count( ) == 1 && immortal_object::LIVE == 2 );
+
+}
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+/* Threads copy without counter updates */
+static void threads_test( )
+{
+
+	const immortal_ptr object_( getObject( ) );
+	std::vector<std::thread> threads_;
+	for ( int i = 0; i < 4; i++ )
+	{
+		threads_.emplace_back( [&object_]( )
+		{
+			for ( int j = 0; j < 100000; j++ )
+				immortal_ptr copy_( object_ );
+		} );
+	}
+	for ( std::thread & thread_ : threads_ )
+		thread_.join( );
+
+	_C0DE4UN_TEST_CHECK_( object_.count( ) == c0de4un::FAST_PTR_IMMORTAL && immortal_object::LIVE == 1 );
+
+}
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+/* MAIN */
+int main( )
+{
+
+	counter_test( );
+	bulk_test( );
+	limit_test( );
+	_C0DE4UN_TEST_CHECK_( immortal_object::LIVE == 1 );
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+	threads_test( );
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+	// Return result
+	return( c0de4un::test::result( "fast_ptr_immortal_test" ) );
+
+}
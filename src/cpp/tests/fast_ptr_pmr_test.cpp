@@ -0,0 +1,138 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 17
+*/
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include allocate_fast
+#include "../fast_ptr_pmr.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Counted object */
+struct pmr_object
+{
+
+	/* Live objects */
+	static int LIVE;
+
+	/* Value */
+	const int mValue;
+
+	/* pmr_object constructor */
+	explicit pmr_object( const int pValue )
+		: mValue( pValue )
+	{ LIVE++; }
+
+	/* pmr_object destructor */
+	~pmr_object( )
+	{ LIVE--; }
+
+};
+
+int pmr_object::LIVE( 0 );
+
+/* Assign raw-pointer to the plain fast_ptr */
+static void assign_test( )
+{
+
+	{
+		c0de4un::fast_ptr<pmr_object> first_( new pmr_object( 1 ) );
+		c0de4un::fast_ptr<pmr_object> second_( first_ );
+
+		// Shared, previous object is kept by the copy
+		first_ = new pmr_object( 2 );
+		_C0DE4UN_TEST_CHECK_( first_->mValue == 2 && first_.count( ) == 1 );
+		_C0DE4UN_TEST_CHECK_( second_->mValue == 1 && second_.count( ) == 1 );
+
+		// Single, previous object is deleted
+		second_ = new pmr_object( 3 );
+		_C0DE4UN_TEST_CHECK_( pmr_object::LIVE == 2 );
+
+		// Null resets
+		second_ = static_cast<pmr_object*>( nullptr );
+		_C0DE4UN_TEST_CHECK_( second_ == nullptr && pmr_object::LIVE == 1 );
+	}
+
+	_C0DE4UN_TEST_CHECK_( pmr_object::LIVE == 0 );
+
+}
+
+#ifdef _C0DE4UN_POINTERS_PMR_ENABLED_
+
+/* Memory resource, which counts allocated bytes */
+class counting_resource final : public std::pmr::memory_resource
+{
+
+public:
+
+	/* Allocated bytes */
+	std::size_t mBytes = 0;
+
+private:
+
+	void * do_allocate( const std::size_t pBytes, const std::size_t pAlignment ) override
+	{
+		mBytes += pBytes;
+		return( std::pmr::new_delete_resource( )->allocate( pBytes, pAlignment ) );
+	}
+
+	void do_deallocate( void *const pMemory, const std::size_t pBytes, const std::size_t pAlignment ) override
+	{
+		mBytes -= pBytes;
+		std::pmr::new_delete_resource( )->deallocate( pMemory, pBytes, pAlignment );
+	}
+
+	bool do_is_equal( const std::pmr::memory_resource & pOther ) const noexcept override
+	{ return( this == &pOther ); }
+
+};
+
+/* Object & block are returned to the resource */
+static void resource_test( )
+{
+
+	counting_resource resource_;
+
+	{
+		c0de4un::fast_ptr<pmr_object> pointer_( c0de4un::allocate_fast<pmr_object>( &resource_, 1 ) );
+		c0de4un::fast_ptr<pmr_object> copy_( pointer_ );
+		_C0DE4UN_TEST_CHECK_( resource_.mBytes > 0 && pointer_->mValue == 1 );
+		copy_.reset( );
+		_C0DE4UN_TEST_CHECK_( resource_.mBytes > 0 );
+	}
+
+	_C0DE4UN_TEST_CHECK_( resource_.mBytes == 0 && pmr_object::LIVE == 0 );
+
+	// Raw-pointer assigned over resource block: block & object are returned, new object gets own block
+	{
+		c0de4un::fast_ptr<pmr_object> pointer_( c0de4un::allocate_fast<pmr_object>( &resource_, 1 ) );
+		pointer_ = new pmr_object( 2 );
+		_C0DE4UN_TEST_CHECK_( resource_.mBytes == 0 && pmr_object::LIVE == 1 );
+		_C0DE4UN_TEST_CHECK_( pointer_->mValue == 2 && pointer_.getBlock( )->mRelease == nullptr );
+	}
+
+	_C0DE4UN_TEST_CHECK_( pmr_object::LIVE == 0 );
+
+}
+
+#endif // _C0DE4UN_POINTERS_PMR_ENABLED_
+
+/* MAIN */
+int main( )
+{
+
+	assign_test( );
+#ifdef _C0DE4UN_POINTERS_PMR_ENABLED_
+	resource_test( );
+#endif // _C0DE4UN_POINTERS_PMR_ENABLED_
+
+	// Return result
+	return( c0de4un::test::result( "fast_ptr_pmr_test" ) );
+
+}
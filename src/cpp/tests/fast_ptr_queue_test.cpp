@@ -0,0 +1,175 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::atomic
+#include <atomic>
+
+// Include std::thread
+#include <thread>
+
+// Include std::vector
+#include <vector>
+
+// Include fast_ptr_queue
+#include "../fast_ptr_queue.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Counted object */
+struct queue_object
+{
+
+	/* Live objects */
+	static std::atomic<int> LIVE;
+
+	/* Value */
+	const std::size_t mValue;
+
+	/* queue_object constructor */
+	explicit queue_object( const std::size_t pValue )
+		: mValue( pValue )
+	{ LIVE++; }
+
+	/* queue_object destructor */
+	~queue_object( )
+	{ LIVE--; }
+
+};
+
+std::atomic<int> queue_object::LIVE( 0 );
+
+/* Type-Alias for pointer */
+using queue_ptr = c0de4un::fast_ptr<queue_object>;
+
+/* Single thread: order, capacity, batches, ownership */
+static void order_test( )
+{
+
+	{
+		c0de4un::fast_ptr_queue<queue_object> queue_( 3 );
+		_C0DE4UN_TEST_CHECK_( queue_.capacity( ) == 4 );
+
+		// Fill
+		queue_ptr pointer_;
+		for ( std::size_t i = 0; i < 4; i++ )
+		{
+			pointer_ = queue_ptr( new queue_object( i ) );
+			_C0DE4UN_TEST_CHECK_( queue_.push( pointer_ ) );
+			_C0DE4UN_TEST_CHECK_( pointer_ == nullptr );
+		}
+
+		// Full, pointer is kept
+		pointer_ = queue_ptr( new queue_object( 4 ) );
+		_C0DE4UN_TEST_CHECK_( !queue_.push( pointer_ ) );
+		_C0DE4UN_TEST_CHECK_( pointer_ != nullptr );
+		pointer_.reset( );
+
+		// FIFO, counters are moved
+		queue_ptr batch_[4];
+		_C0DE4UN_TEST_CHECK_( queue_.popBatch( batch_, 4 ) == 4 );
+		for ( std::size_t i = 0; i < 4; i++ )
+			_C0DE4UN_TEST_CHECK_( batch_[i]->mValue == i && batch_[i].count( ) == 1 );
+
+		// Empty
+		_C0DE4UN_TEST_CHECK_( !queue_.pop( pointer_ ) );
+
+		// Partial batch
+		_C0DE4UN_TEST_CHECK_( queue_.pushBatch( batch_, 4 ) == 4 );
+		queue_ptr more_[2] = { queue_ptr( new queue_object( 5 ) ), queue_ptr( new queue_object( 6 ) ) };
+		_C0DE4UN_TEST_CHECK_( queue_.pushBatch( more_, 2 ) == 0 );
+		_C0DE4UN_TEST_CHECK_( queue_.popBatch( batch_, 1 ) == 1 && batch_[0]->mValue == 0 );
+		_C0DE4UN_TEST_CHECK_( queue_.pushBatch( more_, 2 ) == 1 && more_[0] == nullptr && more_[1] != nullptr );
+	}
+
+	// Left in the queue are released
+	_C0DE4UN_TEST_CHECK_( queue_object::LIVE == 0 );
+
+}
+
+/* Producers & consumers: every pointer is delivered once */
+static void threads_test( )
+{
+
+	const std::size_t threads_( 2 );
+	const std::size_t items_( 2000 );
+	std::atomic<std::size_t> sum_( 0 );
+	std::atomic<std::size_t> received_( 0 );
+
+	{
+		c0de4un::fast_ptr_queue<queue_object> queue_( 64 );
+		std::vector<std::thread> workers_;
+
+		// Producers, batches of 3
+		for ( std::size_t t = 0; t < threads_; t++ )
+		{
+			workers_.emplace_back( [&queue_, t, items_]( )
+			{
+				for ( std::size_t i = 0; i < items_; )
+				{
+					queue_ptr batch_[3];
+					std::size_t count_( 0 );
+					for ( ; count_ < 3 && i + count_ < items_; count_++ )
+						batch_[count_] = queue_ptr( new queue_object( t * items_ + i + count_ + 1 ) );
+					std::size_t pushed_( 0 );
+					while ( pushed_ < count_ )
+					{
+						pushed_ += queue_.pushBatch( batch_ + pushed_, count_ - pushed_ );
+						std::this_thread::yield( );
+					}
+					i += count_;
+				}
+			} );
+		}
+
+		// Consumers
+		for ( std::size_t t = 0; t < threads_; t++ )
+		{
+			workers_.emplace_back( [&queue_, &sum_, &received_, threads_, items_]( )
+			{
+				queue_ptr batch_[4];
+				while ( received_ < threads_ * items_ )
+				{
+					const std::size_t count_( queue_.popBatch( batch_, 4 ) );
+					for ( std::size_t i = 0; i < count_; i++ )
+					{
+						sum_ += batch_[i]->mValue;
+						batch_[i].reset( );
+					}
+					received_ += count_;
+					if ( count_ < 1 )
+						std::this_thread::yield( );
+				}
+			} );
+		}
+
+		for ( std::thread & worker_lr : workers_ )
+			worker_lr.join( );
+	}
+
+	// Sum of 1 .. N
+	const std::size_t total_( threads_ * items_ );
+	_C0DE4UN_TEST_CHECK_( received_ == total_ );
+	_C0DE4UN_TEST_CHECK_( sum_ == total_ * ( total_ + 1 ) / 2 );
+	_C0DE4UN_TEST_CHECK_( queue_object::LIVE == 0 );
+
+}
+
+/* MAIN */
+int main( )
+{
+
+	order_test( );
+	threads_test( );
+
+	// Return result
+	return( c0de4un::test::result( "fast_ptr_queue_test" ) );
+
+}
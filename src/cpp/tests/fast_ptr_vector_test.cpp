@@ -0,0 +1,169 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::move
+#include <utility>
+
+// Include fast_ptr_vector
+#include "../fast_ptr_vector.hxx"
+
+// Include unique_fast_ptr, relocatable specialization
+#include "../unique_fast_ptr.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Counted object */
+struct vector_object
+{
+
+	/* Live objects */
+	static int LIVE;
+
+	/* Value */
+	const std::size_t mValue;
+
+	/* vector_object constructor */
+	explicit vector_object( const std::size_t pValue )
+		: mValue( pValue )
+	{ LIVE++; }
+
+	/* vector_object destructor */
+	~vector_object( )
+	{ LIVE--; }
+
+};
+
+int vector_object::LIVE( 0 );
+
+/* Type-Alias for pointer */
+using vector_ptr = c0de4un::fast_ptr<vector_object>;
+
+/* Type-Alias for vector */
+using object_vector = c0de4un::fast_ptr_vector<vector_object>;
+
+/* Relocation traits */
+static_assert( c0de4un::is_trivially_relocatable<int>::value, "trivially copyable types are relocatable" );
+static_assert( c0de4un::is_trivially_relocatable<vector_ptr>::value, "fast_ptr is relocatable" );
+static_assert( c0de4un::is_trivially_relocatable<c0de4un::unique_fast_ptr<vector_object>>::value, "unique_fast_ptr is relocatable" );
+
+/* Counters & order are kept by reallocation */
+static void growth_test( )
+{
+
+	{
+		object_vector vector_;
+		vector_ptr shared_( new vector_object( 0 ) );
+
+		vector_.push_back( shared_ );
+		for ( std::size_t i = 1; i < 1000; i++ )
+			vector_.push_back( vector_ptr( new vector_object( i ) ) );
+
+		_C0DE4UN_TEST_CHECK_( vector_.size( ) == 1000 && vector_.capacity( ) >= 1000 );
+		_C0DE4UN_TEST_CHECK_( vector_object::LIVE == 1000 && shared_.count( ) == 2 );
+
+		// Order
+		bool ordered_( true );
+		for ( std::size_t i = 0; i < vector_.size( ); i++ )
+			ordered_ = ordered_ && vector_[i]->mValue == i;
+		_C0DE4UN_TEST_CHECK_( ordered_ );
+
+		// Pop
+		vector_.pop_back( );
+		_C0DE4UN_TEST_CHECK_( vector_.size( ) == 999 && vector_object::LIVE == 999 );
+
+		// Shrink
+		vector_.shrink_to_fit( );
+		_C0DE4UN_TEST_CHECK_( vector_.capacity( ) == 999 && vector_[998]->mValue == 998 );
+
+		// Clear
+		vector_.clear( );
+		_C0DE4UN_TEST_CHECK_( vector_.empty( ) && vector_object::LIVE == 1 && shared_.count( ) == 1 );
+
+		vector_.push_back( shared_ );
+	}
+
+	_C0DE4UN_TEST_CHECK_( vector_object::LIVE == 0 );
+
+}
+
+/* Copy shares objects, move transfers buffer */
+static void copy_test( )
+{
+
+	{
+		object_vector first_;
+		for ( std::size_t i = 0; i < 10; i++ )
+			first_.push_back( vector_ptr( new vector_object( i ) ) );
+
+		// Copy
+		object_vector second_( first_ );
+		_C0DE4UN_TEST_CHECK_( second_.size( ) == 10 && second_[0].count( ) == 2 && vector_object::LIVE == 10 );
+
+		// Move
+		object_vector third_( std::move( second_ ) );
+		_C0DE4UN_TEST_CHECK_( second_.empty( ) && third_.size( ) == 10 && third_[0] == first_[0] );
+
+		// Copy assignment releases previous pointers
+		object_vector fourth_;
+		fourth_.push_back( vector_ptr( new vector_object( 100 ) ) );
+		fourth_ = first_;
+		_C0DE4UN_TEST_CHECK_( vector_object::LIVE == 10 && first_[0].count( ) == 3 );
+
+		// Iteration
+		std::size_t sum_( 0 );
+		for ( vector_ptr & pointer_ : fourth_ )
+			sum_ += pointer_->mValue;
+		_C0DE4UN_TEST_CHECK_( sum_ == 45 );
+	}
+
+	_C0DE4UN_TEST_CHECK_( vector_object::LIVE == 0 );
+
+}
+
+/* Element of the same vector is added, while storage is reallocated */
+static void alias_test( )
+{
+
+	{
+		object_vector vector_;
+		vector_.push_back( vector_ptr( new vector_object( 1 ) ) );
+		while ( vector_.size( ) < vector_.capacity( ) )
+			vector_.push_back( vector_ptr( new vector_object( 2 ) ) );
+
+		// Copy
+		const std::size_t capacity_( vector_.capacity( ) );
+		vector_.push_back( vector_[0] );
+		_C0DE4UN_TEST_CHECK_( vector_.capacity( ) > capacity_ );
+		_C0DE4UN_TEST_CHECK_( vector_[vector_.size( ) - 1] == vector_[0] && vector_[0].count( ) == 2 );
+
+		// Move
+		while ( vector_.size( ) < vector_.capacity( ) )
+			vector_.push_back( vector_ptr( new vector_object( 3 ) ) );
+		vector_.push_back( std::move( vector_[1] ) );
+		_C0DE4UN_TEST_CHECK_( vector_[1] == nullptr && vector_[vector_.size( ) - 1]->mValue == 2 && vector_[vector_.size( ) - 1].count( ) == 1 );
+	}
+
+	_C0DE4UN_TEST_CHECK_( vector_object::LIVE == 0 );
+
+}
+
+/* MAIN */
+int main( )
+{
+
+	growth_test( );
+	copy_test( );
+	alias_test( );
+
+	// Return result
+	return( c0de4un::test::result( "fast_ptr_vector_test" ) );
+
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::vector
+#include <vector>
+
+// Include std::chrono
+#include <chrono>
+
+// Include handle_ptr
+#include "../handle_ptr.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Stored object */
+struct handle_object
+{
+
+	/* Value */
+	int mValue;
+
+	/* handle_object constructor */
+	explicit handle_object( const int pValue )
+		: mValue( pValue )
+	{
+	}
+
+};
+
+/* Stale handles, dense objects */
+static void slot_map_test( )
+{
+
+	c0de4un::slot_map<handle_object> map_;
+	const c0de4un::slot_handle first_( map_.emplace( 1 ) );
+	const c0de4un::slot_handle second_( map_.emplace( 2 ) );
+	const c0de4un::slot_handle third_( map_.emplace( 3 ) );
+	_C0DE4UN_TEST_CHECK_( map_.size( ) == 3 && map_.get( second_ )->mValue == 2 );
+
+	// Erase moves last object, handles stay valid
+	_C0DE4UN_TEST_CHECK_( map_.erase( first_ ) );
+	_C0DE4UN_TEST_CHECK_( map_.get( first_ ) == nullptr && !map_.erase( first_ ) );
+	_C0DE4UN_TEST_CHECK_( map_.get( third_ )->mValue == 3 && map_.get( second_ )->mValue == 2 );
+	_C0DE4UN_TEST_CHECK_( map_.end( ) - map_.begin( ) == 2 );
+
+	// Slot is reused with new generation
+	const c0de4un::slot_handle fourth_( map_.emplace( 4 ) );
+	_C0DE4UN_TEST_CHECK_( fourth_.mIndex == first_.mIndex && fourth_ != first_ );
+	_C0DE4UN_TEST_CHECK_( map_.get( first_ ) == nullptr && map_.get( fourth_ )->mValue == 4 );
+
+	// Invalid index
+	_C0DE4UN_TEST_CHECK_( map_.get( c0de4un::slot_handle{ 100, 1 } ) == nullptr );
+
+}
+
+/* Many inserts & erases (amortized growth) */
+static void growth_test( )
+{
+
+	const std::size_t count_( 200000 );
+	c0de4un::slot_map<handle_object> map_;
+	std::vector<c0de4un::slot_handle> handles_;
+
+	const std::chrono::steady_clock::time_point start_( std::chrono::steady_clock::now( ) );
+	for ( std::size_t i = 0; i < count_; i++ )
+		handles_.push_back( map_.emplace( static_cast<int>( i ) ) );
+	const double seconds_( std::chrono::duration<double>( std::chrono::steady_clock::now( ) - start_ ).count( ) );
+
+	// Quadratic growth takes tens of seconds
+	_C0DE4UN_TEST_CHECK_( seconds_ < 5.0 );
+
+	// Erase even, iterate odd
+	for ( std::size_t i = 0; i < count_; i += 2 )
+		map_.erase( handles_[i] );
+	long long sum_( 0 );
+	for ( const handle_object * object_lp = map_.begin( ); object_lp != map_.end( ); object_lp++ )
+		sum_ += object_lp->mValue;
+	_C0DE4UN_TEST_CHECK_( map_.size( ) == count_ / 2 );
+	_C0DE4UN_TEST_CHECK_( sum_ == static_cast<long long>( count_ / 2 ) * static_cast<long long>( count_ / 2 ) );
+	_C0DE4UN_TEST_CHECK_( map_.get( handles_[3] )->mValue == 3 && map_.get( handles_[2] ) == nullptr );
+
+}
+
+/* Process-wide storage */
+static void handle_ptr_test( )
+{
+
+	c0de4un::handle_ptr<handle_object> pointer_( c0de4un::handle_ptr<handle_object>::make( 5 ) );
+	const c0de4un::handle_ptr<handle_object> copy_( pointer_ );
+	_C0DE4UN_TEST_CHECK_( sizeof( pointer_ ) == 8 );
+	_C0DE4UN_TEST_CHECK_( copy_ == pointer_ && copy_->mValue == 5 );
+
+	// Destroyed, copies become null
+	_C0DE4UN_TEST_CHECK_( pointer_.destroy( ) && !pointer_.destroy( ) );
+	_C0DE4UN_TEST_CHECK_( copy_ == nullptr );
+
+	// Null handle
+	_C0DE4UN_TEST_CHECK_( c0de4un::handle_ptr<handle_object>( ) == nullptr );
+
+	c0de4un::ptr_registry<c0de4un::slot_map<handle_object>>::shutdown( );
+
+}
+
+/* MAIN */
+int main( )
+{
+
+	slot_map_test( );
+	growth_test( );
+	handle_ptr_test( );
+
+	// Return result
+	return( c0de4un::test::result( "handle_ptr_test" ) );
+
+}
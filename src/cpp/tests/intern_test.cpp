@@ -0,0 +1,87 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::overflow_error
+#include <stdexcept>
+
+// Include std::string
+#include <string>
+
+// Include std::vector
+#include <vector>
+
+// Include intern
+#include "../intern.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Type-Alias for table */
+using string_table = c0de4un::intern_table<std::string>;
+
+/* Equal values share instance, entry is removed with last instance */
+static void share_test( )
+{
+
+	{
+		c0de4un::fast_ptr<const std::string> first_( c0de4un::intern( std::string( "value" ) ) );
+		const std::string value_( "value" );
+		c0de4un::fast_ptr<const std::string> second_( c0de4un::intern( value_ ) );
+		c0de4un::fast_ptr<const std::string> other_( c0de4un::intern( std::string( "other" ) ) );
+
+		_C0DE4UN_TEST_CHECK_( first_.getPtr( ) == second_.getPtr( ) );
+		_C0DE4UN_TEST_CHECK_( first_.getPtr( ) != other_.getPtr( ) );
+		_C0DE4UN_TEST_CHECK_( string_table::size( ) == 2 );
+	}
+
+	_C0DE4UN_TEST_CHECK_( string_table::size( ) == 0 );
+
+}
+
+/* Value keeps FAST_PTR_IMMORTAL - 1 instances, next intern throws */
+static void limit_test( )
+{
+
+	{
+		std::vector<c0de4un::fast_ptr<const std::string>> values_;
+		values_.reserve( c0de4un::FAST_PTR_IMMORTAL - 1 );
+		for ( std::size_t i = 0; i + 1 < c0de4un::FAST_PTR_IMMORTAL; i++ )
+			values_.push_back( c0de4un::intern( std::string( "limit" ) ) );
+		_C0DE4UN_TEST_CHECK_( values_.back( ).count( ) == c0de4un::FAST_PTR_IMMORTAL - 1 );
+
+		bool thrown_( false );
+		try
+		{
+			c0de4un::intern( std::string( "limit" ) );
+		}
+		catch ( const std::overflow_error & )
+		{
+			thrown_ = true;
+		}
+		_C0DE4UN_TEST_CHECK_( thrown_ && !values_.back( ).isImmortal( ) );
+		_C0DE4UN_TEST_CHECK_( values_.back( ).count( ) == c0de4un::FAST_PTR_IMMORTAL - 1 );
+	}
+
+	// Removed with last instance
+	_C0DE4UN_TEST_CHECK_( string_table::size( ) == 0 );
+
+}
+
+/* MAIN */
+int main( )
+{
+
+	share_test( );
+	limit_test( );
+
+	// Return result
+	return( c0de4un::test::result( "intern_test" ) );
+
+}
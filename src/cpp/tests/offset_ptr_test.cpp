@@ -0,0 +1,186 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::uint64_t
+#include <cstdint>
+
+// Include std::memcpy
+#include <cstring>
+
+// Include std::bad_alloc
+#include <new>
+
+// Include std::vector
+#include <vector>
+
+// Include offset_ptr
+#include "../offset_ptr.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Segment size (bytes) */
+static const std::size_t SEGMENT_SIZE( 4096 );
+
+/* List node, stored in segment */
+struct offset_node
+{
+
+	/* Value */
+	int mValue;
+
+	/* Next node */
+	c0de4un::offset_ptr<offset_node> mNext;
+
+};
+
+/* Counted object, stored in segment */
+struct offset_object
+{
+
+	/* Live objects */
+	static int LIVE;
+
+	/* offset_object constructor */
+	offset_object( )
+	{ LIVE++; }
+
+	/* offset_object destructor */
+	~offset_object( )
+	{ LIVE--; }
+
+};
+
+int offset_object::LIVE( 0 );
+
+/* Pointer copy & null */
+static void pointer_test( )
+{
+
+	int values_[2] = { 1, 2 };
+	c0de4un::offset_ptr<int> first_( &values_[0] );
+	c0de4un::offset_ptr<int> null_;
+	_C0DE4UN_TEST_CHECK_( null_ == nullptr && first_ != nullptr );
+
+	// Copy recalculates offset
+	c0de4un::offset_ptr<int> copy_( first_ );
+	_C0DE4UN_TEST_CHECK_( copy_ == first_ && copy_.getRef( ) == 1 );
+
+	copy_ = &values_[1];
+	_C0DE4UN_TEST_CHECK_( *copy_ == &values_[1] );
+
+	copy_ = nullptr;
+	_C0DE4UN_TEST_CHECK_( copy_ == nullptr && copy_.get( ) == nullptr );
+
+}
+
+/* Objects graph stays valid, when segment is mapped at another address */
+static void segment_test( )
+{
+
+	// 8-byte aligned memory
+	std::vector<std::uint64_t> first_( SEGMENT_SIZE / sizeof( std::uint64_t ) );
+	std::vector<std::uint64_t> second_( first_.size( ) );
+
+	{
+		c0de4un::offset_segment segment_( first_.data( ), SEGMENT_SIZE, true );
+		_C0DE4UN_TEST_CHECK_( segment_.isValid( ) );
+
+		// List 0 -> 1 -> 2
+		offset_node * head_lp( nullptr );
+		for ( int i = 2; i >= 0; i-- )
+		{
+			offset_node *const node_lp( segment_.construct<offset_node>( ) );
+			node_lp->mValue = i;
+			node_lp->mNext = head_lp;
+			head_lp = node_lp;
+		}
+
+		segment_.setRoot( head_lp );
+	}
+
+	// 'Map' at another address
+	std::memcpy( second_.data( ), first_.data( ), SEGMENT_SIZE );
+	std::memset( first_.data( ), 0, SEGMENT_SIZE );
+
+	c0de4un::offset_segment segment_( second_.data( ), SEGMENT_SIZE, false );
+	_C0DE4UN_TEST_CHECK_( segment_.isValid( ) );
+
+	int expected_( 0 );
+	for ( offset_node * node_lp = segment_.getRoot<offset_node>( ); node_lp != nullptr; node_lp = node_lp->mNext.get( ) )
+	{
+		_C0DE4UN_TEST_CHECK_( node_lp->mValue == expected_ );
+		expected_++;
+	}
+	_C0DE4UN_TEST_CHECK_( expected_ == 3 );
+
+	// Not initialized
+	c0de4un::offset_segment empty_( first_.data( ), SEGMENT_SIZE, false );
+	_C0DE4UN_TEST_CHECK_( !empty_.isValid( ) );
+
+}
+
+/* Shared object is destroyed by last instance */
+static void shared_test( )
+{
+
+	std::vector<std::uint64_t> memory_( SEGMENT_SIZE / sizeof( std::uint64_t ) );
+	c0de4un::offset_segment segment_( memory_.data( ), SEGMENT_SIZE, true );
+
+	{
+		c0de4un::shared_offset_ptr<offset_object> first_( segment_.make<offset_object>( ) );
+		_C0DE4UN_TEST_CHECK_( offset_object::LIVE == 1 && first_.count( ) == 1 );
+
+		c0de4un::shared_offset_ptr<offset_object> second_( first_ );
+		_C0DE4UN_TEST_CHECK_( first_.count( ) == 2 && second_ == first_ );
+
+		first_.reset( );
+		_C0DE4UN_TEST_CHECK_( first_ == nullptr && second_.count( ) == 1 && offset_object::LIVE == 1 );
+	}
+
+	_C0DE4UN_TEST_CHECK_( offset_object::LIVE == 0 );
+
+}
+
+/* Full segment throws */
+static void full_test( )
+{
+
+	std::vector<std::uint64_t> memory_( SEGMENT_SIZE / sizeof( std::uint64_t ) );
+	c0de4un::offset_segment segment_( memory_.data( ), SEGMENT_SIZE, true );
+
+	bool thrown_( false );
+	try
+	{
+		segment_.allocate( SEGMENT_SIZE, 8 );
+	}
+	catch ( const std::bad_alloc & )
+	{
+		thrown_ = true;
+	}
+
+	_C0DE4UN_TEST_CHECK_( thrown_ );
+	_C0DE4UN_TEST_CHECK_( segment_.allocate( 64, 8 ) != nullptr );
+
+}
+
+/* MAIN */
+int main( )
+{
+
+	pointer_test( );
+	segment_test( );
+	shared_test( );
+	full_test( );
+
+	// Return result
+	return( c0de4un::test::result( "offset_ptr_test" ) );
+
+}
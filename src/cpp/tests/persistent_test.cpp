@@ -0,0 +1,194 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::map
+#include <map>
+
+// Include std::mt19937
+#include <random>
+
+// Include persistent_vector
+#include "../persistent_vector.hxx"
+
+// Include persistent_map
+#include "../persistent_map.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Hash with collisions, keys differ only in low bit */
+struct colliding_hash
+{
+
+	/* Returns hash of the key */
+	std::size_t operator()( const int pKey ) const noexcept
+	{ return( static_cast<std::size_t>( pKey / 2 ) ); }
+
+};
+
+/* Type-Alias for vector */
+using int_vector = c0de4un::persistent_vector<int>;
+
+/* Type-Alias for map */
+using int_map = c0de4un::persistent_map<int, int>;
+
+/* Returns true, if vector stores values 0 .. size - 1, multiplied by given factor */
+static bool matches( const int_vector & pVector, const std::size_t pSize, const int pFactor )
+{
+
+	if ( pVector.size( ) != pSize )
+		return( false );
+
+	for ( std::size_t i = 0; i < pSize; i++ )
+	{
+		if ( pVector[i] != static_cast<int>( i ) * pFactor )
+			return( false );
+	}
+
+	// Return result
+	return( true );
+
+}
+
+/* Append & remove across levels */
+static void vector_test( )
+{
+
+	int_vector vector_;
+	_C0DE4UN_TEST_CHECK_( vector_.empty( ) );
+
+	// 3 levels
+	const std::size_t size_( 40000 );
+	for ( std::size_t i = 0; i < size_; i++ )
+		vector_.push_back( static_cast<int>( i ) );
+	_C0DE4UN_TEST_CHECK_( matches( vector_, size_, 1 ) );
+
+	for ( std::size_t i = 0; i < size_; i++ )
+		vector_.set( i, static_cast<int>( i ) * 2 );
+	_C0DE4UN_TEST_CHECK_( matches( vector_, size_, 2 ) );
+
+	// Root shrinks
+	while ( vector_.size( ) > 10 )
+		vector_.pop_back( );
+	_C0DE4UN_TEST_CHECK_( matches( vector_, 10, 2 ) );
+	vector_.push_back( 20 );
+	_C0DE4UN_TEST_CHECK_( matches( vector_, 11, 2 ) );
+
+	while ( !vector_.empty( ) )
+		vector_.pop_back( );
+	vector_.push_back( 0 );
+	_C0DE4UN_TEST_CHECK_( matches( vector_, 1, 1 ) );
+
+}
+
+/* Copy is a snapshot, changes don't affect other copies */
+static void vector_snapshot_test( )
+{
+
+	int_vector first_;
+	for ( int i = 0; i < 2000; i++ )
+		first_.push_back( i );
+
+	int_vector second_( first_ );
+	second_.set( 1000, -1 );
+	second_.push_back( 2000 );
+	_C0DE4UN_TEST_CHECK_( matches( first_, 2000, 1 ) );
+	_C0DE4UN_TEST_CHECK_( second_.size( ) == 2001 && second_[1000] == -1 && second_[2000] == 2000 );
+
+	int_vector third_( second_ );
+	while ( third_.size( ) > 500 )
+		third_.pop_back( );
+	_C0DE4UN_TEST_CHECK_( third_.size( ) == 500 && second_.size( ) == 2001 && second_[1999] == 1999 );
+
+	first_.clear( );
+	_C0DE4UN_TEST_CHECK_( first_.empty( ) && second_[0] == 0 && third_[499] == 499 );
+
+}
+
+/* Random updates, compared with std::map */
+template <typename H>
+static void map_test( const int pKeys )
+{
+
+	c0de4un::persistent_map<int, int, H> map_;
+	std::map<int, int> expected_;
+	std::mt19937 random_( 1 );
+
+	for ( int i = 0; i < 20000; i++ )
+	{
+		const int key_( static_cast<int>( random_( ) % static_cast<unsigned int>( pKeys ) ) );
+		if ( random_( ) % 3 == 0 )
+		{
+			_C0DE4UN_TEST_CHECK_( map_.erase( key_ ) == ( expected_.erase( key_ ) > 0 ) );
+		}
+		else
+		{
+			const bool inserted_( expected_.find( key_ ) == expected_.end( ) );
+			expected_[key_] = i;
+			_C0DE4UN_TEST_CHECK_( map_.set( key_, i ) == inserted_ );
+		}
+	}
+
+	_C0DE4UN_TEST_CHECK_( map_.size( ) == expected_.size( ) );
+	bool equal_( true );
+	for ( int key_ = 0; key_ < pKeys; key_++ )
+	{
+		const int *const value_lp( map_.find( key_ ) );
+		const std::map<int, int>::const_iterator expected_value_( expected_.find( key_ ) );
+		if ( expected_value_ == expected_.end( ) )
+			equal_ = equal_ && value_lp == nullptr;
+		else
+			equal_ = equal_ && value_lp != nullptr && *value_lp == expected_value_->second;
+	}
+	_C0DE4UN_TEST_CHECK_( equal_ );
+
+	map_.clear( );
+	_C0DE4UN_TEST_CHECK_( map_.empty( ) && map_.find( 0 ) == nullptr );
+
+}
+
+/* Copy is a snapshot, changes don't affect other copies */
+static void map_snapshot_test( )
+{
+
+	int_map first_;
+	for ( int i = 0; i < 1000; i++ )
+		first_.set( i, i );
+
+	int_map second_( first_ );
+	second_.set( 1, -1 );
+	second_.erase( 2 );
+	second_.set( 1000, 1000 );
+
+	_C0DE4UN_TEST_CHECK_( first_.size( ) == 1000 && *first_.find( 1 ) == 1 && *first_.find( 2 ) == 2 && first_.find( 1000 ) == nullptr );
+	_C0DE4UN_TEST_CHECK_( second_.size( ) == 1000 && *second_.find( 1 ) == -1 && second_.find( 2 ) == nullptr && *second_.find( 1000 ) == 1000 );
+
+	// Erase all from copy
+	int_map third_( first_ );
+	for ( int i = 0; i < 1000; i++ )
+		third_.erase( i );
+	_C0DE4UN_TEST_CHECK_( third_.empty( ) && first_.size( ) == 1000 && *first_.find( 999 ) == 999 );
+
+}
+
+/* MAIN */
+int main( )
+{
+
+	vector_test( );
+	vector_snapshot_test( );
+	map_test<std::hash<int>>( 5000 );
+	map_test<colliding_hash>( 200 );
+	map_snapshot_test( );
+
+	// Return result
+	return( c0de4un::test::result( "persistent_test" ) );
+
+}
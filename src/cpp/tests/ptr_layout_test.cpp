@@ -0,0 +1,112 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::uintptr_t
+#include <cstddef>
+#include <cstdint>
+
+// Include rel_ptr
+#include "../rel_ptr.hpp"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Object with packed entry */
+struct packed_object
+{
+
+	/* Value */
+	int mValue;
+
+};
+
+/* Object with own cache-line entry */
+struct hot_object
+{
+
+	/* Value */
+	int mValue;
+
+};
+
+namespace c0de4un
+{
+
+	/* packed_object layout */
+	template <>
+	struct ptr_layout_traits<packed_object>
+	{
+		/* Layout */
+		static constexpr ptr_layout LAYOUT = ptr_layout::PACKED;
+	};
+
+	/* hot_object layout */
+	template <>
+	struct ptr_layout_traits<hot_object>
+	{
+		/* Layout */
+		static constexpr ptr_layout LAYOUT = ptr_layout::CACHE_LINE;
+	};
+
+	/* Definition of the constants (C++ 11) */
+	constexpr ptr_layout ptr_layout_traits<packed_object>::LAYOUT;
+	constexpr ptr_layout ptr_layout_traits<hot_object>::LAYOUT;
+
+} // namespace c0de4un
+
+/* Type-Alias for fields */
+template <typename T, c0de4un::ptr_layout L>
+using fields_t = c0de4un::rel_ptr_fields<T, L>;
+
+/* Fields layout */
+static_assert( alignof( fields_t<int, c0de4un::ptr_layout::PACKED> ) == 1, "packed fields are not aligned" );
+static_assert( sizeof( fields_t<int, c0de4un::ptr_layout::PACKED> ) == sizeof( unsigned int ) + sizeof( int* ), "packed fields have no padding" );
+static_assert( alignof( fields_t<int, c0de4un::ptr_layout::ALIGNED> ) == alignof( int* ), "aligned fields are naturally aligned" );
+static_assert( alignof( fields_t<int, c0de4un::ptr_layout::CACHE_LINE> ) == c0de4un::CACHE_LINE_SIZE, "cache-line fields are aligned to cache-line" );
+static_assert( sizeof( fields_t<int, c0de4un::ptr_layout::CACHE_LINE> ) == c0de4un::CACHE_LINE_SIZE, "cache-line fields fill cache-line" );
+
+/* Default & specialized selection */
+static_assert( c0de4un::ptr_layout_traits<int>::LAYOUT == c0de4un::ptr_layout::_C0DE4UN_POINTERS_LAYOUT_, "default layout" );
+static_assert( alignof( c0de4un::rel_ptr_data<packed_object> ) < alignof( c0de4un::rel_ptr_data<hot_object> ), "entry layout is selected per type" );
+static_assert( alignof( c0de4un::rel_ptr_data<hot_object> ) == c0de4un::CACHE_LINE_SIZE, "hot entry is on own cache-line" );
+
+/* Pointers work with each layout */
+template <typename T>
+static void pointer_test( )
+{
+
+	T *const object_lp( new T( ) );
+	{
+		c0de4un::rel_ptr<T> first_( object_lp );
+		first_->mValue = 1;
+		c0de4un::rel_ptr<T> second_( object_lp );
+		_C0DE4UN_TEST_CHECK_( first_.count( ) == 2 && second_->mValue == 1 );
+
+		// Entries are aligned, when over-aligned new is available
+		c0de4un::rel_ptr_cache<T> & cache_lr( c0de4un::ptr_registry<c0de4un::rel_ptr_cache<T>>::get( ) );
+		const std::uintptr_t entry_( reinterpret_cast<std::uintptr_t>( &cache_lr.mPointersData.begin( )->second ) );
+		_C0DE4UN_TEST_CHECK_( cache_lr.mPointersData.size( ) == 1 );
+#ifdef __cpp_aligned_new
+		_C0DE4UN_TEST_CHECK_( entry_ % alignof( c0de4un::rel_ptr_data<T> ) == 0 );
+#else
+		( void ) entry_;
+#endif // __cpp_aligned_new
+	}
+
+}
+
+/* MAIN */
+int main( )
+{
+
+	pointer_test<packed_object>( );
+	pointer_test<hot_object>( );
+
+	// Return result
+	return( c0de4un::test::result( "ptr_layout_test" ) );
+
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::atomic
+#include <atomic>
+
+// Include std::thread
+#include <thread>
+
+// Include std::vector
+#include <vector>
+
+// Include ptr_registry
+#include "../ptr_registry.hxx"
+
+// Include rel_ptr
+#include "../rel_ptr.hpp"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Counted registry */
+struct test_registry
+{
+
+	/* Created instances */
+	static std::atomic<int> CREATED;
+
+	/* Live instances */
+	static std::atomic<int> LIVE;
+
+	/* test_registry constructor */
+	test_registry( )
+	{
+		CREATED++;
+		LIVE++;
+	}
+
+	/* test_registry destructor */
+	~test_registry( )
+	{ LIVE--; }
+
+};
+
+std::atomic<int> test_registry::CREATED( 0 );
+std::atomic<int> test_registry::LIVE( 0 );
+
+/* Type-Alias for holder */
+using test_holder = c0de4un::ptr_registry<test_registry>;
+
+/* Static object, releases pointer after main */
+struct static_owner
+{
+
+	/* Pointer */
+	c0de4un::rel_ptr<int> mPointer;
+
+	/* static_owner constructor */
+	static_owner( )
+		: mPointer( new int( 1 ) )
+	{
+	}
+
+};
+
+/* Destroyed after main, registry must be alive */
+static static_owner STATIC_OWNER;
+
+/* Lazy creation, shutdown & re-creation */
+static void lifetime_test( )
+{
+
+	_C0DE4UN_TEST_CHECK_( !test_holder::isInitialized( ) && test_registry::LIVE == 0 );
+
+	// Created on first use
+	test_registry & first_lr( test_holder::get( ) );
+	_C0DE4UN_TEST_CHECK_( test_holder::isInitialized( ) && &test_holder::get( ) == &first_lr );
+	_C0DE4UN_TEST_CHECK_( test_registry::CREATED == 1 );
+
+	// Not re-created
+	test_holder::initialize( );
+	_C0DE4UN_TEST_CHECK_( test_registry::CREATED == 1 );
+
+	// Shutdown
+	test_holder::shutdown( );
+	_C0DE4UN_TEST_CHECK_( !test_holder::isInitialized( ) && test_registry::LIVE == 0 );
+	test_holder::shutdown( );
+
+	// Next use creates new one
+	test_holder::initialize( );
+	_C0DE4UN_TEST_CHECK_( test_registry::CREATED == 2 && test_registry::LIVE == 1 );
+	test_holder::shutdown( );
+
+}
+
+/* Concurrent first use creates single instance */
+static void concurrent_test( )
+{
+
+	const int created_( test_registry::CREATED );
+	std::vector<test_registry*> instances_( 8, nullptr );
+	std::vector<std::thread> threads_;
+	for ( std::size_t i = 0; i < instances_.size( ); i++ )
+		threads_.emplace_back( [&instances_, i]( ) { instances_[i] = &test_holder::get( ); } );
+	for ( std::thread & thread_ : threads_ )
+		thread_.join( );
+
+	_C0DE4UN_TEST_CHECK_( test_registry::CREATED == created_ + 1 && test_registry::LIVE == 1 );
+	bool same_( true );
+	for ( test_registry *const instance_lp : instances_ )
+		same_ = same_ && instance_lp == instances_[0];
+	_C0DE4UN_TEST_CHECK_( same_ );
+
+	test_holder::shutdown( );
+
+}
+
+/* MAIN */
+int main( )
+{
+
+	lifetime_test( );
+	concurrent_test( );
+
+	// Registry of the static pointer is not destroyed by static destruction
+	_C0DE4UN_TEST_CHECK_( c0de4un::ptr_registry<c0de4un::rel_ptr_cache<int>>::isInitialized( ) );
+	_C0DE4UN_TEST_CHECK_( STATIC_OWNER.mPointer.count( ) == 1 );
+
+	// Return result
+	return( c0de4un::test::result( "ptr_registry_test" ) );
+
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Capture Mode
+#define _C0DE4UN_POINTERS_TRACE_ENABLED_
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::uint32_t, std::uint64_t
+#include <cstdint>
+
+// Include std::stringstream
+#include <sstream>
+
+// Include std::thread
+#include <thread>
+
+// Include std::set
+#include <set>
+
+// Include std::vector
+#include <vector>
+
+// Include fast_ptr
+#include "../fast_ptr.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Type-Alias for thread records */
+using trace_records = std::vector<c0de4un::trace_record>;
+
+/*
+ * Saves & reads recorded operations.
+ *
+ * @return - records of the threads, empty if format is not valid.
+*/
+static std::vector<trace_records> load( )
+{
+
+	std::stringstream stream_;
+	c0de4un::ptr_trace::save( stream_ );
+
+	// Header
+	std::uint32_t magic_( 0 ), version_( 0 ), threads_( 0 );
+	stream_.read( reinterpret_cast<char*>( &magic_ ), sizeof( magic_ ) );
+	stream_.read( reinterpret_cast<char*>( &version_ ), sizeof( version_ ) );
+	stream_.read( reinterpret_cast<char*>( &threads_ ), sizeof( threads_ ) );
+	if ( !stream_ || magic_ != c0de4un::TRACE_MAGIC || version_ != c0de4un::TRACE_VERSION )
+		return( std::vector<trace_records>( ) );
+
+	// Threads
+	std::vector<trace_records> result_( threads_ );
+	for ( trace_records & records_lr : result_ )
+	{
+		std::uint32_t count_( 0 );
+		stream_.read( reinterpret_cast<char*>( &count_ ), sizeof( count_ ) );
+		for ( std::uint32_t i = 0; i < count_ && stream_; i++ )
+		{
+			c0de4un::trace_record record_{ 0, 0, c0de4un::trace_op::CREATE };
+			stream_.read( reinterpret_cast<char*>( &record_.mSequence ), sizeof( record_.mSequence ) );
+			stream_.read( reinterpret_cast<char*>( &record_.mObject ), sizeof( record_.mObject ) );
+			stream_.read( reinterpret_cast<char*>( &record_.mOperation ), sizeof( record_.mOperation ) );
+			records_lr.push_back( record_ );
+		}
+	}
+
+	// Return result
+	return( stream_ ? result_ : std::vector<trace_records>( ) );
+
+}
+
+/* Returns true, if record has given operation & object */
+static bool is( const c0de4un::trace_record & pRecord, const c0de4un::trace_op pOperation, const std::uint32_t pObject )
+{ return( pRecord.mOperation == pOperation && pRecord.mObject == pObject ); }
+
+/* Operations of single thread, FREE isn't recorded */
+static void capture_test( )
+{
+
+	c0de4un::ptr_trace::clear( );
+	{
+		c0de4un::fast_ptr<int> first_( new int( 1 ) );
+		c0de4un::fast_ptr<int> second_( first_ );
+		c0de4un::fast_ptr<int> other_( new int( 2 ) );
+	}
+
+	const std::vector<trace_records> threads_( load( ) );
+	_C0DE4UN_TEST_CHECK_( threads_.size( ) == 1 && threads_[0].size( ) == 6 );
+	if ( threads_.size( ) != 1 || threads_[0].size( ) != 6 )
+		return;
+
+	const trace_records & records_lr( threads_[0] );
+	const std::uint32_t first_( records_lr[0].mObject );
+	const std::uint32_t other_( records_lr[2].mObject );
+	_C0DE4UN_TEST_CHECK_( first_ != other_ );
+	_C0DE4UN_TEST_CHECK_( is( records_lr[0], c0de4un::trace_op::CREATE, first_ ) );
+	_C0DE4UN_TEST_CHECK_( is( records_lr[1], c0de4un::trace_op::COPY, first_ ) );
+	_C0DE4UN_TEST_CHECK_( is( records_lr[2], c0de4un::trace_op::CREATE, other_ ) );
+	_C0DE4UN_TEST_CHECK_( is( records_lr[3], c0de4un::trace_op::RELEASE, other_ ) );
+	_C0DE4UN_TEST_CHECK_( is( records_lr[4], c0de4un::trace_op::RELEASE, first_ ) );
+	_C0DE4UN_TEST_CHECK_( is( records_lr[5], c0de4un::trace_op::RELEASE, first_ ) );
+
+	// Sequence order
+	bool ordered_( true );
+	for ( std::size_t i = 1; i < records_lr.size( ); i++ )
+		ordered_ = ordered_ && records_lr[i].mSequence > records_lr[i - 1].mSequence;
+	_C0DE4UN_TEST_CHECK_( ordered_ );
+
+	// Clear
+	c0de4un::ptr_trace::clear( );
+	const std::vector<trace_records> cleared_( load( ) );
+	_C0DE4UN_TEST_CHECK_( cleared_.size( ) == 1 && cleared_[0].empty( ) );
+
+}
+
+/* Threads have own buffers, sequence numbers are global */
+static void threads_test( )
+{
+
+	c0de4un::ptr_trace::clear( );
+
+	// Objects are not shared, counters can be plain
+	c0de4un::fast_ptr<int> main_( new int( 1 ) );
+	std::vector<std::thread> threads_;
+	for ( int i = 0; i < 4; i++ )
+	{
+		threads_.emplace_back( [ ]( )
+		{
+			c0de4un::fast_ptr<int> object_( new int( 2 ) );
+			for ( int j = 0; j < 100; j++ )
+				c0de4un::fast_ptr<int> copy_( object_ );
+		} );
+	}
+	for ( std::thread & thread_ : threads_ )
+		thread_.join( );
+	main_.reset( );
+
+	// Main thread & 4 workers
+	const std::vector<trace_records> buffers_( load( ) );
+	_C0DE4UN_TEST_CHECK_( buffers_.size( ) == 5 );
+
+	std::set<std::uint64_t> sequences_;
+	std::size_t records_( 0 );
+	for ( const trace_records & records_lr : buffers_ )
+	{
+		for ( const c0de4un::trace_record & record_lr : records_lr )
+			sequences_.insert( record_lr.mSequence );
+		records_ += records_lr.size( );
+	}
+
+	// CREATE & RELEASE per object, COPY & RELEASE per copy
+	_C0DE4UN_TEST_CHECK_( records_ == 5 * 2 + 4 * 100 * 2 && sequences_.size( ) == records_ );
+
+}
+
+/* MAIN */
+int main( )
+{
+
+	capture_test( );
+	threads_test( );
+
+	// Return result
+	return( c0de4un::test::result( "ptr_trace_test" ) );
+
+}
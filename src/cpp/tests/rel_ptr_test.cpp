@@ -0,0 +1,229 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::move
+#include <utility>
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+// Include std::thread
+#include <thread>
+
+// Include std::vector
+#include <vector>
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+// Include rel_ptr
+#include "../rel_ptr.hpp"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Counted object */
+struct rel_object
+{
+
+	/* Live objects */
+	static int LIVE;
+
+	/* Value */
+	int mValue;
+
+	/* Payload, larger than registry entry */
+	char mPayload[256];
+
+	/* rel_object constructor */
+	explicit rel_object( const int pValue )
+		: mValue( pValue ),
+		mPayload( )
+	{ LIVE++; }
+
+	/* rel_object destructor */
+	~rel_object( )
+	{ LIVE--; }
+
+};
+
+int rel_object::LIVE( 0 );
+
+/* Type-Alias for pointer */
+using rel_object_ptr = c0de4un::rel_ptr<rel_object>;
+
+/* Objects, allocated by new, & emplaced objects */
+static void emplace_test( )
+{
+
+	// Entry doesn't store object
+	_C0DE4UN_TEST_CHECK_( sizeof( c0de4un::rel_ptr_data<rel_object> ) < sizeof( rel_object ) );
+
+	{
+		rel_object_ptr allocated_( new rel_object( 1 ) );
+		rel_object_ptr emplaced_( rel_object_ptr::emplace( 2 ) );
+		_C0DE4UN_TEST_CHECK_( allocated_->mValue == 1 && emplaced_->mValue == 2 );
+
+		// Raw-pointer lookup, both kinds
+		rel_object_ptr first_( allocated_.get( ) );
+		rel_object_ptr second_( emplaced_.get( ) );
+		_C0DE4UN_TEST_CHECK_( first_ == allocated_ && second_ == emplaced_ );
+		_C0DE4UN_TEST_CHECK_( allocated_.count( ) == 2 && emplaced_.count( ) == 2 );
+		_C0DE4UN_TEST_CHECK_( rel_object_ptr::find( emplaced_.get( ) ).count( ) == 3 );
+	}
+
+	_C0DE4UN_TEST_CHECK_( rel_object::LIVE == 0 );
+
+}
+
+/* Copy & move assignment */
+static void assignment_test( )
+{
+
+	{
+		rel_object_ptr first_( new rel_object( 1 ) );
+		rel_object_ptr second_( new rel_object( 2 ) );
+		rel_object_ptr null_( nullptr );
+
+		// Previous object is released
+		rel_object_ptr & result_lr( first_ = second_ );
+		_C0DE4UN_TEST_CHECK_( &result_lr == &first_ );
+		_C0DE4UN_TEST_CHECK_( rel_object::LIVE == 1 && second_.count( ) == 2 );
+
+		// Null copy
+		rel_object_ptr copy_( null_ );
+		_C0DE4UN_TEST_CHECK_( copy_ == nullptr );
+		first_ = null_;
+		_C0DE4UN_TEST_CHECK_( first_ == nullptr && second_.count( ) == 1 );
+
+		// Move
+		first_ = std::move( second_ );
+		_C0DE4UN_TEST_CHECK_( second_ == nullptr && first_.count( ) == 1 );
+		first_ = rel_object_ptr( new rel_object( 3 ) );
+		_C0DE4UN_TEST_CHECK_( rel_object::LIVE == 1 && first_->mValue == 3 );
+	}
+
+	_C0DE4UN_TEST_CHECK_( rel_object::LIVE == 0 );
+
+}
+
+/* Immortal objects. Entries are kept, so called last & destroys cache. */
+static void immortal_test( )
+{
+
+	rel_object * object_lp( nullptr );
+	{
+		rel_object_ptr immortal_( new rel_object( 1 ) );
+		immortal_.makeImmortal( );
+		object_lp = immortal_.get( );
+
+		rel_object_ptr copy_( immortal_ );
+		_C0DE4UN_TEST_CHECK_( copy_.isImmortal( ) && copy_.count( ) == c0de4un::REL_PTR_IMMORTAL );
+	}
+
+	// Never deleted
+	_C0DE4UN_TEST_CHECK_( rel_object::LIVE == 1 );
+	_C0DE4UN_TEST_CHECK_( rel_object_ptr::find( object_lp ).isImmortal( ) );
+
+#ifdef _C0DE4UN_POINTERS_NODE_HANDLE_
+	// Emplaced object is destroyed with its entry
+	rel_object_ptr( rel_object_ptr::emplace( 2 ) ).makeImmortal( );
+	_C0DE4UN_TEST_CHECK_( rel_object::LIVE == 2 );
+#endif // _C0DE4UN_POINTERS_NODE_HANDLE_
+
+	rel_object_ptr::shutdown( );
+	_C0DE4UN_TEST_CHECK_( rel_object::LIVE == 1 );
+	delete object_lp;
+
+}
+
+/* Retain mode (LRU) */
+static void retain_test( )
+{
+
+	rel_object_ptr::retain( 2, 0 );
+
+	rel_object * first_lp( nullptr );
+	{
+		rel_object_ptr first_( new rel_object( 1 ) );
+		first_lp = first_.get( );
+	}
+
+	// Retained, revived by lookup
+	_C0DE4UN_TEST_CHECK_( rel_object::LIVE == 1 );
+	_C0DE4UN_TEST_CHECK_( rel_object_ptr::find( first_lp ).count( ) == 1 );
+	_C0DE4UN_TEST_CHECK_( rel_object::LIVE == 1 );
+
+	// Revived entry is retained again, not left unlinked. Released first.
+	{
+		rel_object_ptr third_( rel_object_ptr::emplace( 3 ) );
+		rel_object_ptr second_( new rel_object( 2 ) );
+		rel_object_ptr first_( rel_object_ptr::find( first_lp ) );
+	}
+	_C0DE4UN_TEST_CHECK_( rel_object::LIVE == 2 );
+
+	// Least recently released is evicted
+	_C0DE4UN_TEST_CHECK_( rel_object_ptr::find( first_lp ) == nullptr );
+
+	// Disabled, retained are deleted
+	rel_object_ptr::retain( 0, 0 );
+	_C0DE4UN_TEST_CHECK_( rel_object::LIVE == 0 );
+
+}
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+/* Concurrent releases of the last instances */
+static void concurrent_release_test( )
+{
+
+	rel_object_ptr::retain( 1, 0 );
+
+	for ( int i = 0; i < 50; i++ )
+	{
+
+		rel_object_ptr shared_( new rel_object( i ) );
+		rel_object *const object_lp( shared_.get( ) );
+
+		// Each thread owns copy & releases it at the same time
+		std::vector<std::thread> threads_;
+		for ( int t = 0; t < 4; t++ )
+		{
+			rel_object_ptr * copy_lp( new rel_object_ptr( shared_ ) );
+			threads_.emplace_back( [copy_lp]( ) { delete copy_lp; } );
+		}
+		{
+			rel_object_ptr released_( std::move( shared_ ) );
+		}
+		for ( std::thread & thread_lr : threads_ )
+			thread_lr.join( );
+
+		// Retained once, revived once
+		_C0DE4UN_TEST_CHECK_( rel_object_ptr::find( object_lp ).count( ) == 1 );
+
+	}
+
+	rel_object_ptr::retain( 0, 0 );
+	_C0DE4UN_TEST_CHECK_( rel_object::LIVE == 0 );
+
+}
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+/* MAIN */
+int main( )
+{
+
+	emplace_test( );
+	assignment_test( );
+	retain_test( );
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+	concurrent_release_test( );
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+	immortal_test( );
+
+	// Return result
+	return( c0de4un::test::result( "rel_ptr_test" ) );
+
+}
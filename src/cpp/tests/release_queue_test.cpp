@@ -0,0 +1,186 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Iterative Release Mode
+#define _C0DE4UN_POINTERS_ITERATIVE_RELEASE_ENABLED_
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::atomic
+#include <atomic>
+
+// Include std::vector
+#include <vector>
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+// Include std::mutex
+#include <mutex>
+
+// Include std::set
+#include <set>
+
+// Include std::thread
+#include <thread>
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+// Include fast_ptr
+#include "../fast_ptr.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Nesting of the destructors on the current thread */
+static thread_local int DEPTH( 0 );
+
+/* Max nesting of the destructors, checked on single thread */
+static std::atomic<int> MAX_DEPTH( 0 );
+
+/* Decreases nesting, after members are destroyed */
+struct depth_guard
+{
+
+	/* depth_guard destructor */
+	~depth_guard( )
+	{ DEPTH--; }
+
+};
+
+/* Graph node */
+struct release_node
+{
+
+	/* Live objects */
+	static std::atomic<int> LIVE;
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+	/* Threads, which deleted nodes */
+	static std::set<std::thread::id> THREADS;
+
+	/* Threads lock */
+	static std::mutex MUTEX;
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+	/* Destroyed after children */
+	depth_guard mGuard;
+
+	/* Children */
+	std::vector<c0de4un::fast_ptr<release_node>> mChildren;
+
+	/* release_node constructor */
+	release_node( )
+		: mGuard( ),
+		mChildren( )
+	{ LIVE++; }
+
+	/* release_node destructor, children are released after it */
+	~release_node( )
+	{
+
+		LIVE--;
+		DEPTH++;
+		if ( DEPTH > MAX_DEPTH )
+			MAX_DEPTH = DEPTH;
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+		std::lock_guard<std::mutex> lock_( MUTEX );
+		THREADS.insert( std::this_thread::get_id( ) );
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+	}
+
+};
+
+std::atomic<int> release_node::LIVE( 0 );
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+std::set<std::thread::id> release_node::THREADS;
+std::mutex release_node::MUTEX;
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+/* Type-Alias for pointer */
+using node_ptr = c0de4un::fast_ptr<release_node>;
+
+/* Returns tree of the given depth & width */
+static node_ptr tree( const int pDepth, const int pWidth )
+{
+
+	node_ptr result_( new release_node( ) );
+	if ( pDepth > 1 )
+	{
+		for ( int i = 0; i < pWidth; i++ )
+			result_->mChildren.push_back( tree( pDepth - 1, pWidth ) );
+	}
+
+	// Return result
+	return( result_ );
+
+}
+
+/* Long chain is released without recursion */
+static void chain_test( )
+{
+
+	node_ptr head_( new release_node( ) );
+	for ( int i = 0; i < 1000000; i++ )
+	{
+		node_ptr node_( new release_node( ) );
+		node_->mChildren.push_back( head_ );
+		head_ = node_;
+	}
+
+	MAX_DEPTH = 0;
+	head_.reset( );
+	_C0DE4UN_TEST_CHECK_( release_node::LIVE == 0 && MAX_DEPTH == 1 );
+
+}
+
+/* Wide graph, worklist grows over local capacity */
+static void tree_test( )
+{
+
+	node_ptr root_( tree( 4, 16 ) );
+	_C0DE4UN_TEST_CHECK_( release_node::LIVE == 1 + 16 + 256 + 4096 );
+
+	MAX_DEPTH = 0;
+	root_.reset( );
+	_C0DE4UN_TEST_CHECK_( release_node::LIVE == 0 && MAX_DEPTH == 1 );
+
+}
+
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+/* Worklist is split between worker threads */
+static void parallel_test( )
+{
+
+	node_ptr root_( tree( 4, 64 ) );
+	release_node::THREADS.clear( );
+	{
+		c0de4un::parallel_release_scope scope_( 4, 64 );
+		root_.reset( );
+	}
+
+	_C0DE4UN_TEST_CHECK_( release_node::LIVE == 0 );
+	_C0DE4UN_TEST_CHECK_( release_node::THREADS.size( ) > 1 && release_node::THREADS.size( ) <= 5 );
+
+}
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+/* MAIN */
+int main( )
+{
+
+	chain_test( );
+	tree_test( );
+#ifdef _C0DE4UN_MULTITHREADING_ENABLED_
+	parallel_test( );
+#endif // _C0DE4UN_MULTITHREADING_ENABLED_
+
+	// Return result
+	return( c0de4un::test::result( "release_queue_test" ) );
+
+}
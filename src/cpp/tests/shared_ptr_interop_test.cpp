@@ -0,0 +1,117 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::shared_ptr
+#include <memory>
+
+// Include shared_ptr_interop
+#include "../shared_ptr_interop.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Counted object */
+struct interop_object
+{
+
+	/* Live objects */
+	static int LIVE;
+
+	/* interop_object constructor */
+	interop_object( )
+	{ LIVE++; }
+
+	/* interop_object destructor */
+	~interop_object( )
+	{ LIVE--; }
+
+};
+
+int interop_object::LIVE( 0 );
+
+/* Type-Alias for fast_ptr */
+using fast_object_ptr = c0de4un::fast_ptr<interop_object>;
+
+/* Type-Alias for std::shared_ptr */
+using shared_object_ptr = std::shared_ptr<interop_object>;
+
+/* fast_ptr object, shared with std::shared_ptr */
+static void fast_test( )
+{
+
+	fast_object_ptr fast_( new interop_object( ) );
+	shared_object_ptr shared_( c0de4un::to_shared_ptr( fast_ ) );
+	_C0DE4UN_TEST_CHECK_( shared_.get( ) == fast_.getPtr( ) && fast_.count( ) == 2 );
+
+	// Weak pointer doesn't keep object
+	std::weak_ptr<interop_object> weak_( shared_ );
+
+	// Round trip returns original fast_ptr
+	fast_object_ptr back_( c0de4un::to_fast_ptr( shared_ ) );
+	_C0DE4UN_TEST_CHECK_( back_.getBlock( ) == fast_.getBlock( ) && fast_.count( ) == 3 );
+
+	// Object is kept by std::shared_ptr
+	fast_.reset( );
+	back_.reset( );
+	_C0DE4UN_TEST_CHECK_( interop_object::LIVE == 1 );
+
+	shared_.reset( );
+	_C0DE4UN_TEST_CHECK_( interop_object::LIVE == 0 && weak_.expired( ) );
+
+}
+
+/* std::shared_ptr object, shared with fast_ptr */
+static void shared_test( )
+{
+
+	shared_object_ptr shared_( std::make_shared<interop_object>( ) );
+	fast_object_ptr fast_( c0de4un::to_fast_ptr( shared_ ) );
+	_C0DE4UN_TEST_CHECK_( fast_.getPtr( ) == shared_.get( ) && shared_.use_count( ) == 2 );
+
+	// Copies share one std::shared_ptr reference
+	fast_object_ptr copy_( fast_ );
+	_C0DE4UN_TEST_CHECK_( shared_.use_count( ) == 2 );
+
+	// Round trip returns original std::shared_ptr
+	shared_object_ptr back_( c0de4un::to_shared_ptr( fast_ ) );
+	_C0DE4UN_TEST_CHECK_( !back_.owner_before( shared_ ) && !shared_.owner_before( back_ ) );
+
+	// Object is kept by fast_ptr
+	shared_.reset( );
+	back_.reset( );
+	_C0DE4UN_TEST_CHECK_( interop_object::LIVE == 1 );
+
+	fast_.reset( );
+	copy_.reset( );
+	_C0DE4UN_TEST_CHECK_( interop_object::LIVE == 0 );
+
+}
+
+/* Null converts to null */
+static void null_test( )
+{
+
+	_C0DE4UN_TEST_CHECK_( c0de4un::to_shared_ptr( fast_object_ptr( ) ) == nullptr );
+	_C0DE4UN_TEST_CHECK_( c0de4un::to_fast_ptr( shared_object_ptr( ) ) == nullptr );
+
+}
+
+/* MAIN */
+int main( )
+{
+
+	fast_test( );
+	shared_test( );
+	null_test( );
+
+	// Return result
+	return( c0de4un::test::result( "shared_ptr_interop_test" ) );
+
+}
@@ -0,0 +1,354 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::int32_t
+#include <cstdint>
+
+// Include std::string
+#include <string>
+
+// Include std::ostringstream
+#include <sstream>
+
+// Include std::runtime_error
+#include <stdexcept>
+
+// Include snapshot
+#include "../snapshot.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Graph node, fast_ptr edges */
+struct fast_node
+{
+
+	/* Live objects */
+	static int LIVE;
+
+	/* Value */
+	std::int32_t mValue;
+
+	/* Name */
+	std::string mName;
+
+	/* Edge */
+	c0de4un::fast_ptr<fast_node> mNext;
+
+	/* fast_node constructor */
+	fast_node( )
+		: mValue( 0 ),
+		mName( ),
+		mNext( )
+	{ LIVE++; }
+
+	/* fast_node destructor */
+	~fast_node( )
+	{ LIVE--; }
+
+	/* Writes fields */
+	void save( c0de4un::snapshot_writer & pWriter ) const
+	{
+		pWriter.write( mValue );
+		pWriter.write( mName );
+		pWriter.write( mNext );
+	}
+
+	/* Reads fields */
+	void load( c0de4un::snapshot_reader & pReader )
+	{
+		pReader.read( mValue );
+		pReader.read( mName );
+		pReader.read( mNext );
+	}
+
+};
+
+int fast_node::LIVE( 0 );
+
+/* Graph node, rel_ptr edge */
+struct rel_node
+{
+
+	/* Value */
+	std::int32_t mValue;
+
+	/* Edge */
+	c0de4un::rel_ptr<rel_node> mNext;
+
+	/* rel_node constructor */
+	rel_node( )
+		: mValue( 0 ),
+		mNext( nullptr )
+	{
+	}
+
+	/* Writes fields */
+	void save( c0de4un::snapshot_writer & pWriter ) const
+	{
+		pWriter.write( mValue );
+		pWriter.write( mNext );
+	}
+
+	/* Reads fields */
+	void load( c0de4un::snapshot_reader & pReader )
+	{
+		pReader.read( mValue );
+		pReader.read( mNext );
+	}
+
+};
+
+/* Type-Alias for fast_node pointer */
+using fast_node_ptr = c0de4un::fast_ptr<fast_node>;
+
+/* Creates node */
+static fast_node_ptr make_node( const std::int32_t pValue, const char *const pName )
+{
+
+	fast_node_ptr result_( new fast_node( ) );
+	result_.getPtr( )->mValue = pValue;
+	result_.getPtr( )->mName = pName;
+
+	return( result_ );
+
+}
+
+/* Releases chain without recursion */
+static void release_chain( fast_node_ptr & pFirst )
+{
+
+	while ( pFirst != nullptr )
+	{
+		fast_node_ptr next_( pFirst.getPtr( )->mNext );
+		pFirst.getPtr( )->mNext.reset( );
+		pFirst = next_;
+	}
+
+}
+
+/* Sharing, cycles & values are restored */
+static void graph_test( )
+{
+
+	std::ostringstream stream_;
+	{
+		// Cycle: first -> second -> first, shared second
+		fast_node_ptr first_( make_node( 1, "first" ) );
+		fast_node_ptr second_( make_node( 2, "second" ) );
+		first_.getPtr( )->mNext = second_;
+		second_.getPtr( )->mNext = first_;
+
+		c0de4un::snapshot_writer writer_( stream_ );
+		writer_.write( first_ );
+		writer_.write( static_cast<std::int32_t>( 7 ) );
+		writer_.write( second_ );
+		writer_.write( fast_node_ptr( ) );
+		writer_.finish( );
+
+		second_.getPtr( )->mNext.reset( );
+	}
+	_C0DE4UN_TEST_CHECK_( fast_node::LIVE == 0 );
+
+	const std::string data_( stream_.str( ) );
+	fast_node_ptr first_;
+	fast_node_ptr second_;
+	fast_node_ptr null_( make_node( 0, "" ) );
+	{
+		c0de4un::snapshot_reader reader_( data_.data( ), data_.size( ) );
+		std::int32_t value_( 0 );
+		reader_.read( first_ );
+		reader_.read( value_ );
+		reader_.read( second_ );
+		reader_.read( null_ );
+		_C0DE4UN_TEST_CHECK_( value_ == 7 && null_ == nullptr );
+		_C0DE4UN_TEST_CHECK_( reader_.count( ) == 2 && reader_.loaded( ) == 2 );
+	}
+
+	// Shared & cyclic
+	_C0DE4UN_TEST_CHECK_( fast_node::LIVE == 2 );
+	_C0DE4UN_TEST_CHECK_( first_.getPtr( )->mNext.getPtr( ) == second_.getPtr( ) );
+	_C0DE4UN_TEST_CHECK_( second_.getPtr( )->mNext.getPtr( ) == first_.getPtr( ) );
+	_C0DE4UN_TEST_CHECK_( first_.count( ) == 2 && second_.count( ) == 2 );
+	_C0DE4UN_TEST_CHECK_( second_.getPtr( )->mValue == 2 && second_.getPtr( )->mName == "second" );
+
+	second_.getPtr( )->mNext.reset( );
+	first_.reset( );
+	second_.reset( );
+	_C0DE4UN_TEST_CHECK_( fast_node::LIVE == 0 );
+
+}
+
+/* Deep graph doesn't use stack */
+static void deep_test( )
+{
+
+	const std::int32_t size_( 100000 );
+
+	std::ostringstream stream_;
+	{
+		fast_node_ptr first_( make_node( 0, "" ) );
+		fast_node_ptr last_( first_ );
+		for ( std::int32_t i = 1; i < size_; i++ )
+		{
+			last_.getPtr( )->mNext = make_node( i, "" );
+			last_ = last_.getPtr( )->mNext;
+		}
+
+		c0de4un::snapshot_writer writer_( stream_ );
+		writer_.write( first_ );
+		writer_.finish( );
+
+		last_.reset( );
+		release_chain( first_ );
+	}
+
+	const std::string data_( stream_.str( ) );
+	fast_node_ptr first_;
+	{
+		c0de4un::snapshot_reader reader_( data_.data( ), data_.size( ) );
+		reader_.read( first_ );
+	}
+	_C0DE4UN_TEST_CHECK_( fast_node::LIVE == size_ );
+
+	// Order
+	std::int32_t index_( 0 );
+	for ( fast_node * node_lp = first_.getPtr( ); node_lp != nullptr; node_lp = node_lp->mNext.getPtr( ) )
+	{
+		if ( node_lp->mValue != index_ )
+			break;
+		index_++;
+	}
+	_C0DE4UN_TEST_CHECK_( index_ == size_ );
+
+	release_chain( first_ );
+	_C0DE4UN_TEST_CHECK_( fast_node::LIVE == 0 );
+
+}
+
+/* Objects, not reachable from the read pointers, are not loaded */
+static void lazy_test( )
+{
+
+	std::ostringstream stream_;
+	{
+		fast_node_ptr small_( make_node( 1, "small" ) );
+		fast_node_ptr large_( make_node( 2, "large" ) );
+		large_.getPtr( )->mNext = make_node( 3, "" );
+		large_.getPtr( )->mNext.getPtr( )->mNext = small_;
+
+		c0de4un::snapshot_writer writer_( stream_ );
+		writer_.write( small_ );
+		writer_.write( large_ );
+		writer_.finish( );
+	}
+
+	const std::string data_( stream_.str( ) );
+	{
+		c0de4un::snapshot_reader reader_( data_.data( ), data_.size( ) );
+		fast_node_ptr small_;
+		reader_.read( small_ );
+		_C0DE4UN_TEST_CHECK_( reader_.count( ) == 3 && reader_.loaded( ) == 1 );
+		_C0DE4UN_TEST_CHECK_( small_.getPtr( )->mName == "small" );
+
+		// Shared object is not loaded again
+		fast_node_ptr large_;
+		reader_.read( large_ );
+		_C0DE4UN_TEST_CHECK_( reader_.loaded( ) == 3 );
+		_C0DE4UN_TEST_CHECK_( large_.getPtr( )->mNext.getPtr( )->mNext.getPtr( ) == small_.getPtr( ) );
+	}
+	_C0DE4UN_TEST_CHECK_( fast_node::LIVE == 0 );
+
+}
+
+/* rel_ptr graph, objects are registered */
+static void rel_ptr_test( )
+{
+
+	std::ostringstream stream_;
+	{
+		c0de4un::rel_ptr<rel_node> first_( new rel_node( ) );
+		c0de4un::rel_ptr<rel_node> second_( new rel_node( ) );
+		first_->mValue = 1;
+		second_->mValue = 2;
+		first_->mNext = second_;
+
+		c0de4un::snapshot_writer writer_( stream_ );
+		writer_.write( first_ );
+		writer_.write( second_ );
+		writer_.finish( );
+	}
+
+	const std::string data_( stream_.str( ) );
+	c0de4un::rel_ptr<rel_node> first_( nullptr );
+	c0de4un::rel_ptr<rel_node> second_( nullptr );
+	{
+		c0de4un::snapshot_reader reader_( data_.data( ), data_.size( ) );
+		reader_.read( first_ );
+		reader_.read( second_ );
+	}
+
+	_C0DE4UN_TEST_CHECK_( first_->mValue == 1 && second_->mValue == 2 );
+	_C0DE4UN_TEST_CHECK_( first_->mNext == second_ && second_.count( ) == 2 );
+	_C0DE4UN_TEST_CHECK_( c0de4un::rel_ptr<rel_node>::find( second_.get( ) ) == second_ );
+
+}
+
+/* Invalid data */
+static void invalid_test( )
+{
+
+	std::ostringstream stream_;
+	{
+		c0de4un::snapshot_writer writer_( stream_ );
+		writer_.write( make_node( 1, "node" ) );
+	}
+
+	// Not finished
+	const std::string data_( stream_.str( ) );
+	bool thrown_( false );
+	try
+	{
+		c0de4un::snapshot_reader reader_( data_.data( ), data_.size( ) );
+	}
+	catch ( const std::runtime_error & )
+	{
+		thrown_ = true;
+	}
+	_C0DE4UN_TEST_CHECK_( thrown_ );
+
+	// Truncated
+	thrown_ = false;
+	try
+	{
+		c0de4un::snapshot_reader reader_( data_.data( ), 8 );
+	}
+	catch ( const std::runtime_error & )
+	{
+		thrown_ = true;
+	}
+	_C0DE4UN_TEST_CHECK_( thrown_ && fast_node::LIVE == 0 );
+
+}
+
+/* MAIN */
+int main( )
+{
+
+	graph_test( );
+	deep_test( );
+	lazy_test( );
+	rel_ptr_test( );
+	invalid_test( );
+
+	// Return result
+	return( c0de4un::test::result( "snapshot_test" ) );
+
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_TEST_HXX_
+#define _C0DE4UN_TEST_HXX_
+
+// Include std::cerr
+#include <iostream>
+
+// Include EXIT_SUCCESS, EXIT_FAILURE
+#include <cstdlib>
+
+// Checks condition, failure is printed & counted (works with NDEBUG, unlike assert)
+#define _C0DE4UN_TEST_CHECK_( pCondition ) ::c0de4un::test::check( ( pCondition ), #pCondition, __FILE__, __LINE__ )
+
+namespace c0de4un
+{
+
+	namespace test
+	{
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Returns number of failed checks */
+		inline int & failures( ) noexcept
+		{
+
+			static int result_( 0 );
+
+			// Return result
+			return( result_ );
+
+		}
+
+		/*
+		 * Prints & counts failed check.
+		 *
+		 * @param pResult - condition.
+		 * @param pCondition - condition text.
+		 * @param pFile - source file.
+		 * @param pLine - source line.
+		*/
+		inline void check( const bool pResult, const char *const pCondition, const char *const pFile, const int pLine )
+		{
+
+			if ( pResult )
+				return;
+
+			// Print
+			std::cerr << pFile << ":" << pLine << ": check failed: " << pCondition << std::endl;
+
+			// Count
+			failures( )++;
+
+		}
+
+		/* Prints summary & returns exit code */
+		inline int result( const char *const pName )
+		{
+
+			// Failed
+			if ( failures( ) > 0 )
+			{
+				std::cerr << pName << ": " << failures( ) << " check(s) failed" << std::endl;
+				return( EXIT_FAILURE );
+			}
+
+			// Passed
+			std::cout << pName << ": OK" << std::endl;
+			return( EXIT_SUCCESS );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	} // namespace test
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_TEST_HXX_
@@ -0,0 +1,154 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Include std::size_t, std::nullptr_t
+#include <cstddef>
+
+// Include std::move
+#include <utility>
+
+// Include unique_fast_ptr
+#include "../unique_fast_ptr.hxx"
+
+// Include _C0DE4UN_TEST_CHECK_
+#include "test.hxx"
+
+/* Counted object */
+struct unique_object
+{
+
+	/* Live objects */
+	static int LIVE;
+
+	/* Value */
+	const int mValue;
+
+	/* unique_object constructor */
+	explicit unique_object( const int pValue )
+		: mValue( pValue )
+	{ LIVE++; }
+
+	/* unique_object destructor */
+	~unique_object( )
+	{ LIVE--; }
+
+};
+
+int unique_object::LIVE( 0 );
+
+/* Throws from constructor */
+struct failing_object
+{
+
+	/* failing_object constructor */
+	failing_object( )
+	{ throw 1; }
+
+};
+
+/* Single owner: move, reset, destructor */
+static void owner_test( )
+{
+
+	{
+		c0de4un::unique_fast_ptr<unique_object> first_( c0de4un::make_unique_fast<unique_object>( 1 ) );
+		_C0DE4UN_TEST_CHECK_( first_.isReserved( ) && first_->mValue == 1 );
+
+		// Move
+		c0de4un::unique_fast_ptr<unique_object> second_( std::move( first_ ) );
+		_C0DE4UN_TEST_CHECK_( first_ == nullptr && second_ != nullptr );
+
+		// Move assignment deletes previous object
+		c0de4un::unique_fast_ptr<unique_object> adopted_( new unique_object( 2 ) );
+		_C0DE4UN_TEST_CHECK_( !adopted_.isReserved( ) );
+		adopted_ = std::move( second_ );
+		_C0DE4UN_TEST_CHECK_( unique_object::LIVE == 1 && adopted_->mValue == 1 );
+
+		// Reset
+		adopted_.reset( );
+		_C0DE4UN_TEST_CHECK_( unique_object::LIVE == 0 );
+
+		adopted_ = c0de4un::make_unique_fast<unique_object>( 3 );
+	}
+
+	_C0DE4UN_TEST_CHECK_( unique_object::LIVE == 0 );
+
+	// Constructor exception, block is deleted
+	bool thrown_( false );
+	try
+	{
+		c0de4un::make_unique_fast<failing_object>( );
+	}
+	catch ( const int )
+	{
+		thrown_ = true;
+	}
+	_C0DE4UN_TEST_CHECK_( thrown_ );
+
+}
+
+/* Promotion to fast_ptr */
+static void promote_test( )
+{
+
+	// Reserved block is used in place
+	{
+		c0de4un::unique_fast_ptr<unique_object> unique_( c0de4un::make_unique_fast<unique_object>( 1 ) );
+		unique_object *const object_lp( unique_.getPtr( ) );
+		c0de4un::fast_ptr<unique_object> shared_( unique_.promote( ) );
+		_C0DE4UN_TEST_CHECK_( unique_ == nullptr && shared_ == object_lp && shared_.count( ) == 1 );
+		_C0DE4UN_TEST_CHECK_( static_cast<void*>( shared_.getBlock( ) ) < static_cast<void*>( object_lp ) );
+
+		c0de4un::fast_ptr<unique_object> copy_( shared_ );
+		_C0DE4UN_TEST_CHECK_( shared_.count( ) == 2 );
+	}
+
+	_C0DE4UN_TEST_CHECK_( unique_object::LIVE == 0 );
+
+	// Raw-pointer assigned to promoted pointer: reserved block frees own object only
+	{
+		c0de4un::fast_ptr<unique_object> shared_( c0de4un::make_unique_fast<unique_object>( 1 ).promote( ) );
+		shared_ = new unique_object( 2 );
+		_C0DE4UN_TEST_CHECK_( unique_object::LIVE == 1 && shared_->mValue == 2 );
+	}
+
+	_C0DE4UN_TEST_CHECK_( unique_object::LIVE == 0 );
+
+	// Adopted object gets new block
+	{
+		c0de4un::unique_fast_ptr<unique_object> unique_( new unique_object( 1 ) );
+		c0de4un::fast_ptr<unique_object> shared_( unique_.promote( ) );
+		_C0DE4UN_TEST_CHECK_( shared_->mValue == 1 && shared_.count( ) == 1 );
+	}
+
+	// Const object
+	{
+		c0de4un::fast_ptr<const unique_object> shared_( c0de4un::make_unique_fast<const unique_object>( 1 ).promote( ) );
+		_C0DE4UN_TEST_CHECK_( unique_object::LIVE == 1 );
+	}
+
+	// Null
+	{
+		c0de4un::unique_fast_ptr<unique_object> unique_( nullptr );
+		_C0DE4UN_TEST_CHECK_( unique_.promote( ) == nullptr );
+	}
+
+	_C0DE4UN_TEST_CHECK_( unique_object::LIVE == 0 );
+
+}
+
+/* MAIN */
+int main( )
+{
+
+	owner_test( );
+	promote_test( );
+
+	// Return result
+	return( c0de4un::test::result( "unique_fast_ptr_test" ) );
+
+}
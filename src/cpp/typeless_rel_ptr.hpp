@@ -48,6 +48,24 @@
 // Include stdlib
 #include <cstdlib>
 
+// Include std::nullptr_t
+#include <cstddef>
+
+// Include rel_ptr_fields
+#include "ptr_layout.hxx"
+
+// Include ptr_registry
+#include "ptr_registry.hxx"
+
+// Include _C0DE4UN_POINTERS_TRACE_
+#include "ptr_trace.hxx"
+
+// Include _C0DE4UN_POINTERS_BORROW_CHECK_
+#include "borrow_tracker.hxx"
+
+// Include is_trivially_relocatable
+#include "relocatable.hxx"
+
 namespace c0de4un
 {
 
@@ -57,35 +75,23 @@ namespace c0de4un
 	// Types
 	// ===========================================================
 
-// Enable structure-data (fields, variables) alignment (by compilator) to 1 byte
-#pragma pack( push, 1 )
-
 	/*
 	 * typeless_rel_ptr_data - type-independent structure to store shared between 'smart-pointers' data.
+	 *
+	 * (?) Fields (mCounter, mObject) layout is selected by _C0DE4UN_POINTERS_LAYOUT_.
 	*/
-	struct typeless_rel_ptr_data final
+	struct typeless_rel_ptr_data final : public rel_ptr_fields<void, ptr_layout::_C0DE4UN_POINTERS_LAYOUT_>
 	{
 
 		// -------------------------------------------------------- \\
 
-		// ===========================================================
-		// Fields
-		// ===========================================================
-
-		/* Instances counters */
-		std::atomic<unsigned int> mCounter;
-
-		/* Stored Object Instance */
-		void * mObject;
-
 		// ===========================================================
 		// Constructor & destructor
 		// ===========================================================
 
 		/* typeless_rel_ptr_data default constructor */
 		typeless_rel_ptr_data( )
-			: mCounter( 0 ),
-			mObject( nullptr )
+			: rel_ptr_fields<void, ptr_layout::_C0DE4UN_POINTERS_LAYOUT_>( )
 		{
 
 			// Print Log
@@ -188,22 +194,21 @@ namespace c0de4un
 
 	};
 
-// Restore structure-data alignment to default (8-byte on MSVC)
-#pragma pack( pop )
-
 	// -------------------------------------------------------- \\
 
-	// ===========================================================
-	// Fields
-	// ===========================================================
-
-	/* Cache */
-	static typeless_rel_ptr_cache mCache;
-
 	// ===========================================================
 	// Getter & Setter
 	// ===========================================================
 
+	/*
+	 * Returns process-wide cache, creates it on first call.
+	 *
+	 * @thread_safety - thread-safe.
+	 * @throws - std::bad_alloc, mutex.
+	*/
+	inline typeless_rel_ptr_cache & getCache( )
+	{ return( ptr_registry<typeless_rel_ptr_cache>::get( ) ); }
+
 	/*
 	 * Search for 'relative pointer' data for specific Object.
 	 *
@@ -216,7 +221,7 @@ namespace c0de4un
 	 * - mutex ;
 	 * - null (access-violation, etc) ;
 	*/
-	static typeless_rel_ptr_data *const getData( void *const pObject )
+	inline typeless_rel_ptr_data *const getData( void *const pObject )
 	{
 
 		// Cancel
@@ -226,21 +231,30 @@ namespace c0de4un
 		// Print DEBUG to a Console
 		std::cout << "trel_ptr::getData - address=" << pObject << std::endl;
 
+		// Cache
+		typeless_rel_ptr_cache & cache_lr( getCache( ) );
+
 		// Lock Cache
-		mCache.mLock.lock( );
+		cache_lr.mLock.lock( );
 
 		// Get Data using Object-address as key
-		typeless_rel_ptr_data * result_lp( &mCache.mPointersData[pObject] );
+		typeless_rel_ptr_data * result_lp( &cache_lr.mPointersData[pObject] );
 
 		// Set Data's Object 'raw-pointer' value
 		if ( result_lp->mObject == nullptr )
+		{
+			_C0DE4UN_POINTERS_TRACE_( CREATE, pObject );
 			result_lp->mObject = pObject; // Copy address
+		}
+		else
+			_C0DE4UN_POINTERS_TRACE_( LOOKUP, pObject );
 
-		// Increase 'pointers' counter
-		result_lp->mCounter++;
+		// Increase 'pointers' counter, if object is not immortal
+		if ( !is_immortal( result_lp ) )
+			result_lp->mCounter++;
 
 		// Unlock Cache
-		mCache.mLock.unlock( );
+		cache_lr.mLock.unlock( );
 
 		// Return result
 		return( result_lp );
@@ -251,6 +265,25 @@ namespace c0de4un
 	// Methods
 	// ===========================================================
 
+	/*
+	 * Creates process-wide cache, if it's not created yet. Optional, cache is
+	 * created on first use.
+	 *
+	 * @throws - std::bad_alloc, mutex.
+	*/
+	inline void typeless_rel_ptr_initialize( )
+	{ ptr_registry<typeless_rel_ptr_cache>::initialize( ); }
+
+	/*
+	 * Destroys process-wide cache. Cache is never destroyed by static destruction.
+	 *
+	 * (!) Call only when all trel_ptr instances are released.
+	 *
+	 * @throws - mutex.
+	*/
+	inline void typeless_rel_ptr_shutdown( )
+	{ ptr_registry<typeless_rel_ptr_cache>::shutdown( ); }
+
 	/*
 	 * Removes Data associated with the given Object.
 	 *
@@ -261,7 +294,7 @@ namespace c0de4un
 	 * - null (access-violation, etc) ;
 	*/
 	template <typename T>
-	static void removeData( void *const pObject )
+	inline void removeData( void *const pObject )
 	{
 
 		// Cancel
@@ -271,18 +304,25 @@ namespace c0de4un
 		// Print DEBUG to a Console
 		std::cout << "trel_ptr::removeData - address=" << pObject << std::endl;
 
+		// Cache
+		typeless_rel_ptr_cache & cache_lr( getCache( ) );
+
 		// Lock Cache
-		mCache.mLock.lock( );
+		cache_lr.mLock.lock( );
 
 		// Search
-		std::map<void const*, typeless_rel_ptr_data>::const_iterator dataPos = mCache.mPointersData.find( pObject );
+		std::map<void const*, typeless_rel_ptr_data>::const_iterator dataPos = cache_lr.mPointersData.find( pObject );
 
 		// Remove Data
-		if ( dataPos != mCache.mPointersData.cend( ) )
+		if ( dataPos != cache_lr.mPointersData.cend( ) )
 		{
 
+			// Trace
+			_C0DE4UN_POINTERS_TRACE_( FREE, pObject );
+			_C0DE4UN_POINTERS_BORROW_CHECK_( pObject );
+
 			// Remove Data from a map
-			mCache.mPointersData.erase( dataPos );
+			cache_lr.mPointersData.erase( dataPos );
 
 			// Delete Object instance
 			delete (T*const)pObject;
@@ -290,7 +330,7 @@ namespace c0de4un
 		}
 
 		// Unlock Cache
-		mCache.mLock.unlock( );
+		cache_lr.mLock.unlock( );
 
 	}
 
@@ -317,6 +357,34 @@ namespace c0de4un
 		/* Data */
 		typeless_rel_ptr_data * mData;
 
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Releases Data, 'pointer' becomes null */
+		void release( )
+		{
+
+			// Update Data, immortal data is not changed
+			if ( mData != nullptr && !is_immortal( mData ) )
+			{
+
+				// Trace
+				_C0DE4UN_POINTERS_TRACE_( RELEASE, mData->mObject );
+
+				// Decrease instances counter
+				if ( mData->mCounter > 1 )
+					mData->mCounter--;
+				else // Remove Data & Release Object
+					removeData<T>( mData->mObject );
+
+			}
+
+			// Reset
+			mData = nullptr;
+
+		}
+
 		// -------------------------------------------------------- \\
 
 	public:
@@ -355,11 +423,13 @@ namespace c0de4un
 			// Get Data
 			mData = pOther.mData;
 
-			// Update instances counter
+			// Update instances counter, if object is not immortal
 			if ( mData != nullptr )
 			{
 
-				mData->mCounter++;
+				_C0DE4UN_POINTERS_TRACE_( COPY, mData->mObject );
+				if ( !is_immortal( mData ) )
+					mData->mCounter++;
 
 				// Print Log
 				std::cout << "trel_ptr::copy-constructor, Object address=" << mData->mObject << std::endl;
@@ -402,17 +472,8 @@ namespace c0de4un
 			else
 				std::cout << "trel_ptr::destructor, null data" << std::endl;
 
-			// Update Data
-			if ( mData != nullptr )
-			{
-
-				// Decrease instances counter
-				if ( mData->mCounter > 1 )
-					mData->mCounter--;
-				else // Remove Data & Release Object
-					removeData<T>( mData->mObject );
-
-			}
+			// Release Data
+			release( );
 
 		}
 
@@ -438,14 +499,21 @@ namespace c0de4un
 				return( *this );
 
 			// Print Log
-			std::cout << "trel_ptr::copy-assignment operator, Object address=" << mData != nullptr ? mData->mObject : 0 << std::endl;
+			std::cout << "trel_ptr::copy-assignment operator, Object address=" << ( mData != nullptr ? mData->mObject : nullptr ) << std::endl;
+
+			// Increase instances counter, if object is not immortal
+			typeless_rel_ptr_data *const data_lp( pOther.mData );
+			if ( data_lp != nullptr && !is_immortal( data_lp ) )
+				data_lp->mCounter++;
+
+			// Release previous Data
+			release( );
 
 			// Set Data
-			mData = pOther.mData;
+			mData = data_lp;
 
-			// Increase instances counter
-			if ( mData != nullptr )
-				mData->mCounter++;
+			// Return
+			return( *this );
 
 		}
 
@@ -462,7 +530,10 @@ namespace c0de4un
 				return( *this );
 
 			// Print Log
-			std::cout << "trel_ptr::move-assignment operator, Object address=" << mData != nullptr ? mData->mObject : 0 << std::endl;
+			std::cout << "trel_ptr::move-assignment operator, Object address=" << ( mData != nullptr ? mData->mObject : nullptr ) << std::endl;
+
+			// Release previous Data
+			release( );
 
 			// Set Data
 			mData = pOther.mData;
@@ -470,8 +541,42 @@ namespace c0de4un
 			// Reset
 			pOther.mData = nullptr;
 
+			// Return
+			return( *this );
+
+		}
+
+		/*
+		 * Makes object immortal: copies & destructors don't change the counter &
+		 * don't use thread-lock. Object is never deleted.
+		 *
+		 * (!) Call before object is shared between threads.
+		 * (?) Does nothing, if 'pointer' is null.
+		 *
+		 * @thread_safety - thread-lock used.
+		 * @throws - std::bad_alloc, mutex.
+		*/
+		void makeImmortal( )
+		{
+
+			// Cancel
+			if ( mData == nullptr )
+				return;
+
+			// Cache
+			typeless_rel_ptr_cache & cache_lr( getCache( ) );
+
+			// Set counter
+			cache_lr.mLock.lock( );
+			mData->mCounter = REL_PTR_IMMORTAL;
+			cache_lr.mLock.unlock( );
+
 		}
 
+		/* Returns true, if object is immortal, see #makeImmortal */
+		const bool isImmortal( ) const noexcept
+		{ return( is_immortal( mData ) ); }
+
 		/* Returns instances counter */
 		const unsigned int count( )
 		{
@@ -488,19 +593,19 @@ namespace c0de4un
 		}
 
 		T *const operator*( )
-		{ return( mData != nullptr ? mData->mObject : nullptr ); }
+		{ return( mData != nullptr ? static_cast<T*>( mData->mObject ) : nullptr ); }
 
 		/* Returns true if 'pointer' is nullptr */
-		const bool operator==( nullptr_t ) const noexcept
+		const bool operator==( std::nullptr_t ) const noexcept
 		{ return( mData == nullptr || mData->mObject == nullptr ); }
 
 		/* Returns true if 'pointer' is not nullptr */
-		const bool operator!=( nullptr_t ) const noexcept
+		const bool operator!=( std::nullptr_t ) const noexcept
 		{ return( mData != nullptr || mData->mObject != nullptr ); }
 
 		/* Pointer address access operator */
 		T *const operator->( ) noexcept
-		{ return( mData != nullptr ? mData->mObject : nullptr ); }
+		{ return( mData != nullptr ? static_cast<T*>( mData->mObject ) : nullptr ); }
 
 		/* Returns true if this instance stores same object as given one. */
 		const bool operator==( const trel_ptr<T> & pOther ) const noexcept
@@ -531,4 +636,10 @@ namespace c0de4un
 
 	// -------------------------------------------------------- \\
 
+	/* trel_ptr stores only address of the registry data, can be moved with memcpy */
+	template <typename T>
+	struct is_trivially_relocatable<trel_ptr<T>> : public std::true_type
+	{
+	};
+
 } // namespace c0de4un
\ No newline at end of file
@@ -0,0 +1,376 @@
+/*
+ * Copyright  2018 Denis Zyamaev. Email: (code4un@yandex.ru)
+ * License: MIT (see "LICENSE" file)
+ * Author: Denis Zyamaev (code4un@yandex.ru)
+ * API: C++ 11
+*/
+
+// Pragma
+#pragma once
+
+#ifndef _C0DE4UN_UNIQUE_FAST_PTR_HXX_
+#define _C0DE4UN_UNIQUE_FAST_PTR_HXX_
+
+// Include std::nullptr_t
+#include <cstddef>
+
+// Include std::aligned_storage
+#include <type_traits>
+
+// Include std::forward
+#include <utility>
+
+// Include placement new
+#include <new>
+
+// Include fast_ptr
+#include "fast_ptr.hxx"
+
+// Mark as Declared, in cases of Forward Declaration
+#define _C0DE4UN_UNIQUE_FAST_PTR_DECL_
+
+namespace c0de4un
+{
+
+	// -------------------------------------------------------- \\
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/*
+	 * unique_fast_block - reserved fast_ptr control block & object.
+	 *
+	 * (?) Single allocation. Counter is initialized, but not used, until
+	 * unique_fast_ptr is promoted to fast_ptr.
+	*/
+	template <typename T>
+	struct unique_fast_block final : public fast_ptr_block
+	{
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Object storage */
+		typename std::aligned_storage<sizeof( T ), alignof( T )>::type mStorage;
+
+		// ===========================================================
+		// Constructor
+		// ===========================================================
+
+		/* unique_fast_block constructor */
+		unique_fast_block( ) noexcept
+			: fast_ptr_block( &unique_fast_block<T>::release ),
+			mStorage( )
+		{
+		}
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Destroys object & deletes block */
+		static void release( fast_ptr_block *const pBlock, void *const pObject )
+		{
+
+			// Destroy
+			static_cast<T*>( pObject )->~T( );
+
+			// Delete
+			delete static_cast<unique_fast_block<T>*>( pBlock );
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	/*
+	 * unique_fast_ptr - single owner pointer, which can be promoted to fast_ptr.
+	 *
+	 * Owner doesn't use counter (no atomic operations). Objects, created by
+	 * make_unique_fast, have reserved control block in the same allocation, so
+	 * #promote doesn't allocate: block becomes fast_ptr control block in place.
+	 *
+	 * (?) Adopted 'raw-pointer' has no reserved block, it's allocated by #promote.
+	 *
+	 * @version 0.1.0
+	*/
+	template <typename T>
+	class unique_fast_ptr final
+	{
+
+	private:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Fields
+		// ===========================================================
+
+		/* Owned object */
+		T * mObject;
+
+		/* Reserved control block, null for adopted object */
+		fast_ptr_block * mBlock;
+
+		// ===========================================================
+		// Deleted
+		// ===========================================================
+
+		/* @deleted unique_fast_ptr const copy constructor */
+		unique_fast_ptr( const unique_fast_ptr & ) = delete;
+
+		/* @deleted unique_fast_ptr const copy assignment operator */
+		unique_fast_ptr & operator=( const unique_fast_ptr & ) = delete;
+
+		// ===========================================================
+		// Methods
+		// ===========================================================
+
+		/* Deletes object & reserved block. Resets this instance. */
+		void release( ) noexcept
+		{
+
+			if ( mObject != nullptr )
+			{
+
+				// Trace
+				_C0DE4UN_POINTERS_TRACE_( FREE, mObject );
+				_C0DE4UN_POINTERS_BORROW_CHECK_( mObject );
+
+				// Delete Object & block
+				if ( mBlock != nullptr )
+					fast_ptr<T>::destroy( mObject, mBlock );
+				else
+					delete mObject;
+
+			}
+
+			// Reset
+			mObject = nullptr;
+			mBlock = nullptr;
+
+		}
+
+		// -------------------------------------------------------- \\
+
+	public:
+
+		// -------------------------------------------------------- \\
+
+		// ===========================================================
+		// Constructors & Destructor
+		// ===========================================================
+
+		/*
+		 * unique_fast_ptr constructor, adopts object.
+		 *
+		 * @param pObject - object, allocated by new, or null.
+		*/
+		explicit unique_fast_ptr( T *const pObject = nullptr ) noexcept
+			: mObject( pObject ),
+			mBlock( nullptr )
+		{
+
+			// Trace
+			if ( pObject != nullptr )
+				_C0DE4UN_POINTERS_TRACE_( CREATE, pObject );
+
+		}
+
+		/*
+		 * unique_fast_ptr constructor with reserved control block.
+		 *
+		 * (!) Block must be not shared (counter is 1). Block's release function
+		 * frees object & block, see make_unique_fast.
+		 *
+		 * @param pObject - object.
+		 * @param pBlock - control block.
+		*/
+		unique_fast_ptr( T *const pObject, fast_ptr_block *const pBlock ) noexcept
+			: mObject( pObject ),
+			mBlock( pBlock )
+		{
+
+			// Trace
+			_C0DE4UN_POINTERS_TRACE_( CREATE, pObject );
+
+		}
+
+		/* unique_fast_ptr null constructor */
+		unique_fast_ptr( std::nullptr_t ) noexcept
+			: mObject( nullptr ),
+			mBlock( nullptr )
+		{
+		}
+
+		/* unique_fast_ptr move constructor */
+		unique_fast_ptr( unique_fast_ptr && pOther ) noexcept
+			: mObject( pOther.mObject ),
+			mBlock( pOther.mBlock )
+		{
+
+			// Reset moved
+			pOther.mObject = nullptr;
+			pOther.mBlock = nullptr;
+
+		}
+
+		/* unique_fast_ptr move assignment operator */
+		unique_fast_ptr & operator=( unique_fast_ptr && pOther ) noexcept
+		{
+
+			// Cancel if self-move
+			if ( this == &pOther )
+				return( *this );
+
+			// Release previous object
+			release( );
+
+			// Copy values
+			mObject = pOther.mObject;
+			mBlock = pOther.mBlock;
+
+			// Reset moved
+			pOther.mObject = nullptr;
+			pOther.mBlock = nullptr;
+
+			// Return
+			return( *this );
+
+		}
+
+		/* unique_fast_ptr destructor */
+		~unique_fast_ptr( ) noexcept
+		{ release( ); }
+
+		// ===========================================================
+		// Methods & Operators
+		// ===========================================================
+
+		/*
+		 * Moves object to fast_ptr, this instance becomes null.
+		 *
+		 * (?) Reserved control block is used in place (counter is 1), without
+		 * allocation. For adopted object, control block is allocated.
+		 *
+		 * @return - fast_ptr, single instance, null if this instance is null.
+		 * @throws - std::bad_alloc, for adopted object only.
+		*/
+		fast_ptr<T> promote( )
+		{
+
+			// Result
+			fast_ptr<T> result_;
+
+			// Cancel
+			if ( mObject == nullptr )
+				return( result_ );
+
+			// Control block, counter is 1
+			result_.mCounter = mBlock != nullptr ? mBlock : new fast_ptr_block( );
+			result_.mObject = mObject;
+
+			// Reset
+			mObject = nullptr;
+			mBlock = nullptr;
+
+			// Return result
+			return( result_ );
+
+		}
+
+		/* Deletes object, 'pointer' becomes null */
+		void reset( ) noexcept
+		{ release( ); }
+
+		/* Returns 'reference'. (!) Don't call on null-value. */
+		T & getRef( ) const noexcept
+		{ return( *mObject ); }
+
+		/* Returns 'raw-pointer' */
+		T *const getPtr( ) const noexcept
+		{ return( mObject ); }
+
+		/* Returns 'raw-pointer' to the object instance, can be null. */
+		T *const operator*( ) noexcept
+		{ return( mObject ); }
+
+		/* Pointer address access operator */
+		T *const operator->( ) noexcept
+		{ return( mObject ); }
+
+		/* Returns true, if control block is reserved & #promote doesn't allocate */
+		const bool isReserved( ) const noexcept
+		{ return( mBlock != nullptr ); }
+
+		/* Returns true if 'pointer' is nullptr */
+		const bool operator==( std::nullptr_t ) const noexcept
+		{ return( mObject == nullptr ); }
+
+		/* Returns true if 'pointer' is not nullptr */
+		const bool operator!=( std::nullptr_t ) const noexcept
+		{ return( mObject != nullptr ); }
+
+		/* Returns true if given object instance is the same as the stored one. */
+		const bool operator==( T *const pObject ) const noexcept
+		{ return( mObject == pObject ); }
+
+		// -------------------------------------------------------- \\
+
+	};
+
+	// ===========================================================
+	// Methods
+	// ===========================================================
+
+	/*
+	 * Constructs object with reserved fast_ptr control block, single allocation.
+	 *
+	 * @param pArgs - object constructor arguments.
+	 * @return - unique_fast_ptr, #promote doesn't allocate.
+	 * @throws - std::bad_alloc, or object constructor exception.
+	*/
+	template <typename T, typename... Args>
+	inline unique_fast_ptr<T> make_unique_fast( Args&&... pArgs )
+	{
+
+		// Allocate
+		unique_fast_block<T> *const block_lp( new unique_fast_block<T>( ) );
+
+		// Construct Object
+		T * object_lp( nullptr );
+		try
+		{
+			object_lp = new( &block_lp->mStorage ) T( std::forward<Args>( pArgs )... );
+		}
+		catch ( ... )
+		{
+			delete block_lp;
+			throw;
+		}
+
+		// Return result
+		return( unique_fast_ptr<T>( object_lp, block_lp ) );
+
+	}
+
+	// ===========================================================
+	// Types
+	// ===========================================================
+
+	/* unique_fast_ptr stores only addresses of the object & block, can be moved with memcpy */
+	template <typename T>
+	struct is_trivially_relocatable<unique_fast_ptr<T>> : public std::true_type
+	{
+	};
+
+	// -------------------------------------------------------- \\
+
+} // namespace c0de4un
+
+#endif // !_C0DE4UN_UNIQUE_FAST_PTR_HXX_